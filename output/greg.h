@@ -0,0 +1,2562 @@
+/* An OpenGL extension loader generated by GREG
+ * Copyright © Camilla Berglund <dreda@dreda.org>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would
+ *    be appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not
+ *    be misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source
+ *    distribution.
+ */
+
+/* Parts of this file are reproduced from the OpenGL XML specification.
+ * Copyright (c) 2013 The Khronos Group Inc.
+ */
+
+#ifndef _greg_h_
+#define _greg_h_
+
+/* GREG replaces gl.h and glext.h */
+#define __gl_h_
+#define __GL_H__
+#define __glext_h_
+#define __GLEXT_H__
+#define __gltypes_h_
+
+/* Standardize on _WIN32 as the Windows macro */
+#if !defined(_WIN32) && (defined(__WIN32__) || defined(WIN32))
+ #define _WIN32
+#endif /* _WIN32 */
+
+/* Define GLAPIENTRY if not already defined */
+#if !defined(GLAPIENTRY)
+ #if defined(_WIN32)
+  #define GLAPIENTRY __stdcall
+ #else
+  #define GLAPIENTRY
+ #endif
+#endif /* GLAPIENTRY */
+
+/* The type of every entry in the function pointer table, shared with the
+ * window system loaders */
+#if !defined(GREG_PROC_DEFINED)
+ #define GREG_PROC_DEFINED
+typedef void (*GREGproc)(void);
+#endif /* GREG_PROC_DEFINED */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Define GREG_THREAD_LOCAL for per-thread state */
+#if defined(_MSC_VER)
+ #define GREG_THREAD_LOCAL __declspec(thread)
+#else
+ #define GREG_THREAD_LOCAL __thread
+#endif
+
+/* Define GREG_CACHE_ALIGNED for the start of the function pointer table */
+#if defined(_MSC_VER)
+ #define GREG_CACHE_ALIGNED __declspec(align(64))
+#elif defined(__GNUC__)
+ #define GREG_CACHE_ALIGNED __attribute__((aligned(64)))
+#else
+ #define GREG_CACHE_ALIGNED
+#endif
+
+/* The number of words in a set of capabilities, of 32 bits each */
+#define GREG_CAPABILITY_WORDS ((1 + 31) / 32)
+
+/* The supported versions and extensions of a context as one bit each, at the
+ * indices of their booleans, so the whole set can be copied, compared or
+ * hashed at once
+ */
+typedef struct GregCapabilities
+{
+    unsigned long bits[GREG_CAPABILITY_WORDS];
+} GregCapabilities;
+
+/* Tests the capability at the specified index, like GREG_VERSION_3_0_INDEX,
+ * in the specified set of capabilities with a single load and mask */
+#define GREG_HAS_CAPABILITY(set, index) \
+    ((int) (((set).bits[(index) / 32] >> ((index) % 32)) & 1))
+
+#if defined(GREG_MULTI_CONTEXT)
+
+/* The version, booleans, capabilities and function pointers of an
+ * OpenGL ES context
+ */
+typedef struct GregContext
+{
+    struct
+    {
+        int major;
+        int minor;
+    } version;
+    int booleans[1];
+    GregCapabilities capabilities;
+    GREG_CACHE_ALIGNED GREGproc procs[144];
+} GregContext;
+
+/* The current context of the calling thread */
+extern GREG_THREAD_LOCAL GregContext* greg_context;
+
+ #define GREG_BOOLEANS greg_context->booleans
+ #define GREG_CAPABILITIES greg_context->capabilities
+ #define GREG_PROCS greg_context->procs
+
+#else
+
+/* The version and extension booleans, capabilities and function pointers */
+extern int greg_booleans[];
+extern GregCapabilities greg_capabilities;
+extern GREGproc greg_procs[];
+
+ #define GREG_BOOLEANS greg_booleans
+ #define GREG_CAPABILITIES greg_capabilities
+ #define GREG_PROCS greg_procs
+
+#endif /* GREG_MULTI_CONTEXT */
+
+/* Tests the capability at the specified index in the current context */
+#define GREG_SUPPORTED(index) GREG_HAS_CAPABILITY(GREG_CAPABILITIES, index)
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(GREG_STATIC)
+ #define GREGDEF static
+#else
+ #define GREGDEF extern
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* OpenGL ES version macros */
+#define GL_VERSION_ES_CM_1_0 1
+
+/* OpenGL ES extension macros */
+
+/* OpenGL ES version booleans */
+#define GREG_VERSION_ES_CM_1_0 GREG_BOOLEANS[0]
+#define GREG_VERSION_ES_CM_1_0_INDEX 0
+
+/* OpenGL ES extension booleans */
+
+/* OpenGL ES types */
+#include <KHR/khrplatform.h>
+typedef unsigned int GLenum;
+typedef unsigned char GLboolean;
+typedef unsigned int GLbitfield;
+typedef void GLvoid;
+typedef int GLint;
+typedef unsigned int GLuint;
+typedef int GLsizei;
+typedef khronos_int32_t GLclampx;
+typedef khronos_uint8_t GLubyte;
+typedef khronos_float_t GLfloat;
+typedef khronos_int32_t GLfixed;
+typedef khronos_intptr_t GLintptr;
+typedef khronos_ssize_t GLsizeiptr;
+
+/* OpenGL ES enumeration values */
+#define GL_DEPTH_BUFFER_BIT 0x00000100
+#define GL_STENCIL_BUFFER_BIT 0x00000400
+#define GL_COLOR_BUFFER_BIT 0x00004000
+#define GL_FALSE 0
+#define GL_NO_ERROR 0
+#define GL_ZERO 0
+#define GL_TRUE 1
+#define GL_ONE 1
+#define GL_VERSION_ES_CL_1_0 1
+#define GL_VERSION_ES_CM_1_1 1
+#define GL_VERSION_ES_CL_1_1 1
+#define GL_POINTS 0x0000
+#define GL_LINES 0x0001
+#define GL_LINE_LOOP 0x0002
+#define GL_LINE_STRIP 0x0003
+#define GL_TRIANGLES 0x0004
+#define GL_TRIANGLE_STRIP 0x0005
+#define GL_TRIANGLE_FAN 0x0006
+#define GL_ADD 0x0104
+#define GL_NEVER 0x0200
+#define GL_LESS 0x0201
+#define GL_EQUAL 0x0202
+#define GL_LEQUAL 0x0203
+#define GL_GREATER 0x0204
+#define GL_NOTEQUAL 0x0205
+#define GL_GEQUAL 0x0206
+#define GL_ALWAYS 0x0207
+#define GL_SRC_COLOR 0x0300
+#define GL_ONE_MINUS_SRC_COLOR 0x0301
+#define GL_SRC_ALPHA 0x0302
+#define GL_ONE_MINUS_SRC_ALPHA 0x0303
+#define GL_DST_ALPHA 0x0304
+#define GL_ONE_MINUS_DST_ALPHA 0x0305
+#define GL_DST_COLOR 0x0306
+#define GL_ONE_MINUS_DST_COLOR 0x0307
+#define GL_SRC_ALPHA_SATURATE 0x0308
+#define GL_FRONT 0x0404
+#define GL_BACK 0x0405
+#define GL_FRONT_AND_BACK 0x0408
+#define GL_INVALID_ENUM 0x0500
+#define GL_INVALID_VALUE 0x0501
+#define GL_INVALID_OPERATION 0x0502
+#define GL_STACK_OVERFLOW 0x0503
+#define GL_STACK_UNDERFLOW 0x0504
+#define GL_OUT_OF_MEMORY 0x0505
+#define GL_EXP 0x0800
+#define GL_EXP2 0x0801
+#define GL_CW 0x0900
+#define GL_CCW 0x0901
+#define GL_CURRENT_COLOR 0x0B00
+#define GL_CURRENT_NORMAL 0x0B02
+#define GL_CURRENT_TEXTURE_COORDS 0x0B03
+#define GL_POINT_SMOOTH 0x0B10
+#define GL_POINT_SIZE 0x0B11
+#define GL_SMOOTH_POINT_SIZE_RANGE 0x0B12
+#define GL_LINE_SMOOTH 0x0B20
+#define GL_LINE_WIDTH 0x0B21
+#define GL_SMOOTH_LINE_WIDTH_RANGE 0x0B22
+#define GL_CULL_FACE 0x0B44
+#define GL_CULL_FACE_MODE 0x0B45
+#define GL_FRONT_FACE 0x0B46
+#define GL_LIGHTING 0x0B50
+#define GL_LIGHT_MODEL_TWO_SIDE 0x0B52
+#define GL_LIGHT_MODEL_AMBIENT 0x0B53
+#define GL_SHADE_MODEL 0x0B54
+#define GL_COLOR_MATERIAL 0x0B57
+#define GL_FOG 0x0B60
+#define GL_FOG_DENSITY 0x0B62
+#define GL_FOG_START 0x0B63
+#define GL_FOG_END 0x0B64
+#define GL_FOG_MODE 0x0B65
+#define GL_FOG_COLOR 0x0B66
+#define GL_DEPTH_RANGE 0x0B70
+#define GL_DEPTH_TEST 0x0B71
+#define GL_DEPTH_WRITEMASK 0x0B72
+#define GL_DEPTH_CLEAR_VALUE 0x0B73
+#define GL_DEPTH_FUNC 0x0B74
+#define GL_STENCIL_TEST 0x0B90
+#define GL_STENCIL_CLEAR_VALUE 0x0B91
+#define GL_STENCIL_FUNC 0x0B92
+#define GL_STENCIL_VALUE_MASK 0x0B93
+#define GL_STENCIL_FAIL 0x0B94
+#define GL_STENCIL_PASS_DEPTH_FAIL 0x0B95
+#define GL_STENCIL_PASS_DEPTH_PASS 0x0B96
+#define GL_STENCIL_REF 0x0B97
+#define GL_STENCIL_WRITEMASK 0x0B98
+#define GL_MATRIX_MODE 0x0BA0
+#define GL_NORMALIZE 0x0BA1
+#define GL_VIEWPORT 0x0BA2
+#define GL_MODELVIEW_STACK_DEPTH 0x0BA3
+#define GL_PROJECTION_STACK_DEPTH 0x0BA4
+#define GL_TEXTURE_STACK_DEPTH 0x0BA5
+#define GL_MODELVIEW_MATRIX 0x0BA6
+#define GL_PROJECTION_MATRIX 0x0BA7
+#define GL_TEXTURE_MATRIX 0x0BA8
+#define GL_ALPHA_TEST 0x0BC0
+#define GL_ALPHA_TEST_FUNC 0x0BC1
+#define GL_ALPHA_TEST_REF 0x0BC2
+#define GL_DITHER 0x0BD0
+#define GL_BLEND_DST 0x0BE0
+#define GL_BLEND_SRC 0x0BE1
+#define GL_BLEND 0x0BE2
+#define GL_LOGIC_OP_MODE 0x0BF0
+#define GL_COLOR_LOGIC_OP 0x0BF2
+#define GL_SCISSOR_BOX 0x0C10
+#define GL_SCISSOR_TEST 0x0C11
+#define GL_COLOR_CLEAR_VALUE 0x0C22
+#define GL_COLOR_WRITEMASK 0x0C23
+#define GL_PERSPECTIVE_CORRECTION_HINT 0x0C50
+#define GL_POINT_SMOOTH_HINT 0x0C51
+#define GL_LINE_SMOOTH_HINT 0x0C52
+#define GL_FOG_HINT 0x0C54
+#define GL_UNPACK_ALIGNMENT 0x0CF5
+#define GL_PACK_ALIGNMENT 0x0D05
+#define GL_ALPHA_SCALE 0x0D1C
+#define GL_MAX_LIGHTS 0x0D31
+#define GL_MAX_CLIP_PLANES 0x0D32
+#define GL_MAX_TEXTURE_SIZE 0x0D33
+#define GL_MAX_MODELVIEW_STACK_DEPTH 0x0D36
+#define GL_MAX_PROJECTION_STACK_DEPTH 0x0D38
+#define GL_MAX_TEXTURE_STACK_DEPTH 0x0D39
+#define GL_MAX_VIEWPORT_DIMS 0x0D3A
+#define GL_SUBPIXEL_BITS 0x0D50
+#define GL_RED_BITS 0x0D52
+#define GL_GREEN_BITS 0x0D53
+#define GL_BLUE_BITS 0x0D54
+#define GL_ALPHA_BITS 0x0D55
+#define GL_DEPTH_BITS 0x0D56
+#define GL_STENCIL_BITS 0x0D57
+#define GL_TEXTURE_2D 0x0DE1
+#define GL_DONT_CARE 0x1100
+#define GL_FASTEST 0x1101
+#define GL_NICEST 0x1102
+#define GL_AMBIENT 0x1200
+#define GL_DIFFUSE 0x1201
+#define GL_SPECULAR 0x1202
+#define GL_POSITION 0x1203
+#define GL_SPOT_DIRECTION 0x1204
+#define GL_SPOT_EXPONENT 0x1205
+#define GL_SPOT_CUTOFF 0x1206
+#define GL_CONSTANT_ATTENUATION 0x1207
+#define GL_LINEAR_ATTENUATION 0x1208
+#define GL_QUADRATIC_ATTENUATION 0x1209
+#define GL_BYTE 0x1400
+#define GL_UNSIGNED_BYTE 0x1401
+#define GL_SHORT 0x1402
+#define GL_UNSIGNED_SHORT 0x1403
+#define GL_FLOAT 0x1406
+#define GL_FIXED 0x140C
+#define GL_CLEAR 0x1500
+#define GL_AND 0x1501
+#define GL_AND_REVERSE 0x1502
+#define GL_COPY 0x1503
+#define GL_AND_INVERTED 0x1504
+#define GL_NOOP 0x1505
+#define GL_XOR 0x1506
+#define GL_OR 0x1507
+#define GL_NOR 0x1508
+#define GL_EQUIV 0x1509
+#define GL_INVERT 0x150A
+#define GL_OR_REVERSE 0x150B
+#define GL_COPY_INVERTED 0x150C
+#define GL_OR_INVERTED 0x150D
+#define GL_NAND 0x150E
+#define GL_SET 0x150F
+#define GL_EMISSION 0x1600
+#define GL_SHININESS 0x1601
+#define GL_AMBIENT_AND_DIFFUSE 0x1602
+#define GL_MODELVIEW 0x1700
+#define GL_PROJECTION 0x1701
+#define GL_TEXTURE 0x1702
+#define GL_ALPHA 0x1906
+#define GL_RGB 0x1907
+#define GL_RGBA 0x1908
+#define GL_LUMINANCE 0x1909
+#define GL_LUMINANCE_ALPHA 0x190A
+#define GL_FLAT 0x1D00
+#define GL_SMOOTH 0x1D01
+#define GL_KEEP 0x1E00
+#define GL_REPLACE 0x1E01
+#define GL_INCR 0x1E02
+#define GL_DECR 0x1E03
+#define GL_VENDOR 0x1F00
+#define GL_RENDERER 0x1F01
+#define GL_VERSION 0x1F02
+#define GL_EXTENSIONS 0x1F03
+#define GL_MODULATE 0x2100
+#define GL_DECAL 0x2101
+#define GL_TEXTURE_ENV_MODE 0x2200
+#define GL_TEXTURE_ENV_COLOR 0x2201
+#define GL_TEXTURE_ENV 0x2300
+#define GL_NEAREST 0x2600
+#define GL_LINEAR 0x2601
+#define GL_NEAREST_MIPMAP_NEAREST 0x2700
+#define GL_LINEAR_MIPMAP_NEAREST 0x2701
+#define GL_NEAREST_MIPMAP_LINEAR 0x2702
+#define GL_LINEAR_MIPMAP_LINEAR 0x2703
+#define GL_TEXTURE_MAG_FILTER 0x2800
+#define GL_TEXTURE_MIN_FILTER 0x2801
+#define GL_TEXTURE_WRAP_S 0x2802
+#define GL_TEXTURE_WRAP_T 0x2803
+#define GL_REPEAT 0x2901
+#define GL_POLYGON_OFFSET_UNITS 0x2A00
+#define GL_CLIP_PLANE0 0x3000
+#define GL_CLIP_PLANE1 0x3001
+#define GL_CLIP_PLANE2 0x3002
+#define GL_CLIP_PLANE3 0x3003
+#define GL_CLIP_PLANE4 0x3004
+#define GL_CLIP_PLANE5 0x3005
+#define GL_LIGHT0 0x4000
+#define GL_LIGHT1 0x4001
+#define GL_LIGHT2 0x4002
+#define GL_LIGHT3 0x4003
+#define GL_LIGHT4 0x4004
+#define GL_LIGHT5 0x4005
+#define GL_LIGHT6 0x4006
+#define GL_LIGHT7 0x4007
+#define GL_UNSIGNED_SHORT_4_4_4_4 0x8033
+#define GL_UNSIGNED_SHORT_5_5_5_1 0x8034
+#define GL_POLYGON_OFFSET_FILL 0x8037
+#define GL_POLYGON_OFFSET_FACTOR 0x8038
+#define GL_RESCALE_NORMAL 0x803A
+#define GL_TEXTURE_BINDING_2D 0x8069
+#define GL_VERTEX_ARRAY 0x8074
+#define GL_NORMAL_ARRAY 0x8075
+#define GL_COLOR_ARRAY 0x8076
+#define GL_TEXTURE_COORD_ARRAY 0x8078
+#define GL_VERTEX_ARRAY_SIZE 0x807A
+#define GL_VERTEX_ARRAY_TYPE 0x807B
+#define GL_VERTEX_ARRAY_STRIDE 0x807C
+#define GL_NORMAL_ARRAY_TYPE 0x807E
+#define GL_NORMAL_ARRAY_STRIDE 0x807F
+#define GL_COLOR_ARRAY_SIZE 0x8081
+#define GL_COLOR_ARRAY_TYPE 0x8082
+#define GL_COLOR_ARRAY_STRIDE 0x8083
+#define GL_TEXTURE_COORD_ARRAY_SIZE 0x8088
+#define GL_TEXTURE_COORD_ARRAY_TYPE 0x8089
+#define GL_TEXTURE_COORD_ARRAY_STRIDE 0x808A
+#define GL_VERTEX_ARRAY_POINTER 0x808E
+#define GL_NORMAL_ARRAY_POINTER 0x808F
+#define GL_COLOR_ARRAY_POINTER 0x8090
+#define GL_TEXTURE_COORD_ARRAY_POINTER 0x8092
+#define GL_MULTISAMPLE 0x809D
+#define GL_SAMPLE_ALPHA_TO_COVERAGE 0x809E
+#define GL_SAMPLE_ALPHA_TO_ONE 0x809F
+#define GL_SAMPLE_COVERAGE 0x80A0
+#define GL_SAMPLE_BUFFERS 0x80A8
+#define GL_SAMPLES 0x80A9
+#define GL_SAMPLE_COVERAGE_VALUE 0x80AA
+#define GL_SAMPLE_COVERAGE_INVERT 0x80AB
+#define GL_POINT_SIZE_MIN 0x8126
+#define GL_POINT_SIZE_MAX 0x8127
+#define GL_POINT_FADE_THRESHOLD_SIZE 0x8128
+#define GL_POINT_DISTANCE_ATTENUATION 0x8129
+#define GL_CLAMP_TO_EDGE 0x812F
+#define GL_GENERATE_MIPMAP 0x8191
+#define GL_GENERATE_MIPMAP_HINT 0x8192
+#define GL_UNSIGNED_SHORT_5_6_5 0x8363
+#define GL_ALIASED_POINT_SIZE_RANGE 0x846D
+#define GL_ALIASED_LINE_WIDTH_RANGE 0x846E
+#define GL_TEXTURE0 0x84C0
+#define GL_TEXTURE1 0x84C1
+#define GL_TEXTURE2 0x84C2
+#define GL_TEXTURE3 0x84C3
+#define GL_TEXTURE4 0x84C4
+#define GL_TEXTURE5 0x84C5
+#define GL_TEXTURE6 0x84C6
+#define GL_TEXTURE7 0x84C7
+#define GL_TEXTURE8 0x84C8
+#define GL_TEXTURE9 0x84C9
+#define GL_TEXTURE10 0x84CA
+#define GL_TEXTURE11 0x84CB
+#define GL_TEXTURE12 0x84CC
+#define GL_TEXTURE13 0x84CD
+#define GL_TEXTURE14 0x84CE
+#define GL_TEXTURE15 0x84CF
+#define GL_TEXTURE16 0x84D0
+#define GL_TEXTURE17 0x84D1
+#define GL_TEXTURE18 0x84D2
+#define GL_TEXTURE19 0x84D3
+#define GL_TEXTURE20 0x84D4
+#define GL_TEXTURE21 0x84D5
+#define GL_TEXTURE22 0x84D6
+#define GL_TEXTURE23 0x84D7
+#define GL_TEXTURE24 0x84D8
+#define GL_TEXTURE25 0x84D9
+#define GL_TEXTURE26 0x84DA
+#define GL_TEXTURE27 0x84DB
+#define GL_TEXTURE28 0x84DC
+#define GL_TEXTURE29 0x84DD
+#define GL_TEXTURE30 0x84DE
+#define GL_TEXTURE31 0x84DF
+#define GL_ACTIVE_TEXTURE 0x84E0
+#define GL_CLIENT_ACTIVE_TEXTURE 0x84E1
+#define GL_MAX_TEXTURE_UNITS 0x84E2
+#define GL_SUBTRACT 0x84E7
+#define GL_COMBINE 0x8570
+#define GL_COMBINE_RGB 0x8571
+#define GL_COMBINE_ALPHA 0x8572
+#define GL_RGB_SCALE 0x8573
+#define GL_ADD_SIGNED 0x8574
+#define GL_INTERPOLATE 0x8575
+#define GL_CONSTANT 0x8576
+#define GL_PRIMARY_COLOR 0x8577
+#define GL_PREVIOUS 0x8578
+#define GL_SRC0_RGB 0x8580
+#define GL_SRC1_RGB 0x8581
+#define GL_SRC2_RGB 0x8582
+#define GL_SRC0_ALPHA 0x8588
+#define GL_SRC1_ALPHA 0x8589
+#define GL_SRC2_ALPHA 0x858A
+#define GL_OPERAND0_RGB 0x8590
+#define GL_OPERAND1_RGB 0x8591
+#define GL_OPERAND2_RGB 0x8592
+#define GL_OPERAND0_ALPHA 0x8598
+#define GL_OPERAND1_ALPHA 0x8599
+#define GL_OPERAND2_ALPHA 0x859A
+#define GL_NUM_COMPRESSED_TEXTURE_FORMATS 0x86A2
+#define GL_COMPRESSED_TEXTURE_FORMATS 0x86A3
+#define GL_DOT3_RGB 0x86AE
+#define GL_DOT3_RGBA 0x86AF
+#define GL_BUFFER_SIZE 0x8764
+#define GL_BUFFER_USAGE 0x8765
+#define GL_ARRAY_BUFFER 0x8892
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#define GL_ARRAY_BUFFER_BINDING 0x8894
+#define GL_ELEMENT_ARRAY_BUFFER_BINDING 0x8895
+#define GL_VERTEX_ARRAY_BUFFER_BINDING 0x8896
+#define GL_NORMAL_ARRAY_BUFFER_BINDING 0x8897
+#define GL_COLOR_ARRAY_BUFFER_BINDING 0x8898
+#define GL_TEXTURE_COORD_ARRAY_BUFFER_BINDING 0x889A
+#define GL_STATIC_DRAW 0x88E4
+#define GL_DYNAMIC_DRAW 0x88E8
+
+/* OpenGL ES function typedefs */
+typedef void  (GLAPIENTRY *PFNGLACTIVETEXTUREPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLALPHAFUNCPROC)(GLenum, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLALPHAFUNCXPROC)(GLenum, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLBINDBUFFERPROC)(GLenum, GLuint);
+typedef void  (GLAPIENTRY *PFNGLBINDTEXTUREPROC)(GLenum, GLuint);
+typedef void  (GLAPIENTRY *PFNGLBLENDFUNCPROC)(GLenum, GLenum);
+typedef void  (GLAPIENTRY *PFNGLBUFFERDATAPROC)(GLenum, GLsizeiptr, const void *, GLenum);
+typedef void  (GLAPIENTRY *PFNGLBUFFERSUBDATAPROC)(GLenum, GLintptr, GLsizeiptr, const void *);
+typedef void  (GLAPIENTRY *PFNGLCLEARPROC)(GLbitfield);
+typedef void  (GLAPIENTRY *PFNGLCLEARCOLORPROC)(GLfloat, GLfloat, GLfloat, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLCLEARCOLORXPROC)(GLfixed, GLfixed, GLfixed, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLCLEARDEPTHFPROC)(GLfloat);
+typedef void  (GLAPIENTRY *PFNGLCLEARDEPTHXPROC)(GLfixed);
+typedef void  (GLAPIENTRY *PFNGLCLEARSTENCILPROC)(GLint);
+typedef void  (GLAPIENTRY *PFNGLCLIENTACTIVETEXTUREPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLCLIPPLANEFPROC)(GLenum, const GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLCLIPPLANEXPROC)(GLenum, const GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLCOLOR4FPROC)(GLfloat, GLfloat, GLfloat, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLCOLOR4UBPROC)(GLubyte, GLubyte, GLubyte, GLubyte);
+typedef void  (GLAPIENTRY *PFNGLCOLOR4XPROC)(GLfixed, GLfixed, GLfixed, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLCOLORMASKPROC)(GLboolean, GLboolean, GLboolean, GLboolean);
+typedef void  (GLAPIENTRY *PFNGLCOLORPOINTERPROC)(GLint, GLenum, GLsizei, const void *);
+typedef void  (GLAPIENTRY *PFNGLCOMPRESSEDTEXIMAGE2DPROC)(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const void *);
+typedef void  (GLAPIENTRY *PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void *);
+typedef void  (GLAPIENTRY *PFNGLCOPYTEXIMAGE2DPROC)(GLenum, GLint, GLenum, GLint, GLint, GLsizei, GLsizei, GLint);
+typedef void  (GLAPIENTRY *PFNGLCOPYTEXSUBIMAGE2DPROC)(GLenum, GLint, GLint, GLint, GLint, GLint, GLsizei, GLsizei);
+typedef void  (GLAPIENTRY *PFNGLCULLFACEPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLDELETEBUFFERSPROC)(GLsizei, const GLuint *);
+typedef void  (GLAPIENTRY *PFNGLDELETETEXTURESPROC)(GLsizei, const GLuint *);
+typedef void  (GLAPIENTRY *PFNGLDEPTHFUNCPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLDEPTHMASKPROC)(GLboolean);
+typedef void  (GLAPIENTRY *PFNGLDEPTHRANGEFPROC)(GLfloat, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLDEPTHRANGEXPROC)(GLfixed, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLDISABLEPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLDISABLECLIENTSTATEPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLDRAWARRAYSPROC)(GLenum, GLint, GLsizei);
+typedef void  (GLAPIENTRY *PFNGLDRAWELEMENTSPROC)(GLenum, GLsizei, GLenum, const void *);
+typedef void  (GLAPIENTRY *PFNGLENABLEPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLENABLECLIENTSTATEPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLFINISHPROC)(void);
+typedef void  (GLAPIENTRY *PFNGLFLUSHPROC)(void);
+typedef void  (GLAPIENTRY *PFNGLFOGFPROC)(GLenum, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLFOGFVPROC)(GLenum, const GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLFOGXPROC)(GLenum, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLFOGXVPROC)(GLenum, const GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLFRONTFACEPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLFRUSTUMFPROC)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLFRUSTUMXPROC)(GLfixed, GLfixed, GLfixed, GLfixed, GLfixed, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLGENBUFFERSPROC)(GLsizei, GLuint *);
+typedef void  (GLAPIENTRY *PFNGLGENTEXTURESPROC)(GLsizei, GLuint *);
+typedef void  (GLAPIENTRY *PFNGLGETBOOLEANVPROC)(GLenum, GLboolean *);
+typedef void  (GLAPIENTRY *PFNGLGETBUFFERPARAMETERIVPROC)(GLenum, GLenum, GLint *);
+typedef void  (GLAPIENTRY *PFNGLGETCLIPPLANEFPROC)(GLenum, GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLGETCLIPPLANEXPROC)(GLenum, GLfixed *);
+typedef GLenum (GLAPIENTRY *PFNGLGETERRORPROC)(void);
+typedef void  (GLAPIENTRY *PFNGLGETFIXEDVPROC)(GLenum, GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLGETFLOATVPROC)(GLenum, GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLGETINTEGERVPROC)(GLenum, GLint *);
+typedef void  (GLAPIENTRY *PFNGLGETLIGHTFVPROC)(GLenum, GLenum, GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLGETLIGHTXVPROC)(GLenum, GLenum, GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLGETMATERIALFVPROC)(GLenum, GLenum, GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLGETMATERIALXVPROC)(GLenum, GLenum, GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLGETPOINTERVPROC)(GLenum, void **);
+typedef const GLubyte * (GLAPIENTRY *PFNGLGETSTRINGPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLGETTEXENVFVPROC)(GLenum, GLenum, GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLGETTEXENVIVPROC)(GLenum, GLenum, GLint *);
+typedef void  (GLAPIENTRY *PFNGLGETTEXENVXVPROC)(GLenum, GLenum, GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLGETTEXPARAMETERFVPROC)(GLenum, GLenum, GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLGETTEXPARAMETERIVPROC)(GLenum, GLenum, GLint *);
+typedef void  (GLAPIENTRY *PFNGLGETTEXPARAMETERXVPROC)(GLenum, GLenum, GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLHINTPROC)(GLenum, GLenum);
+typedef GLboolean (GLAPIENTRY *PFNGLISBUFFERPROC)(GLuint);
+typedef GLboolean (GLAPIENTRY *PFNGLISENABLEDPROC)(GLenum);
+typedef GLboolean (GLAPIENTRY *PFNGLISTEXTUREPROC)(GLuint);
+typedef void  (GLAPIENTRY *PFNGLLIGHTMODELFPROC)(GLenum, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLLIGHTMODELFVPROC)(GLenum, const GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLLIGHTMODELXPROC)(GLenum, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLLIGHTMODELXVPROC)(GLenum, const GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLLIGHTFPROC)(GLenum, GLenum, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLLIGHTFVPROC)(GLenum, GLenum, const GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLLIGHTXPROC)(GLenum, GLenum, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLLIGHTXVPROC)(GLenum, GLenum, const GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLLINEWIDTHPROC)(GLfloat);
+typedef void  (GLAPIENTRY *PFNGLLINEWIDTHXPROC)(GLfixed);
+typedef void  (GLAPIENTRY *PFNGLLOADIDENTITYPROC)(void);
+typedef void  (GLAPIENTRY *PFNGLLOADMATRIXFPROC)(const GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLLOADMATRIXXPROC)(const GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLLOGICOPPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLMATERIALFPROC)(GLenum, GLenum, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLMATERIALFVPROC)(GLenum, GLenum, const GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLMATERIALXPROC)(GLenum, GLenum, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLMATERIALXVPROC)(GLenum, GLenum, const GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLMATRIXMODEPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLMULTMATRIXFPROC)(const GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLMULTMATRIXXPROC)(const GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLMULTITEXCOORD4FPROC)(GLenum, GLfloat, GLfloat, GLfloat, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLMULTITEXCOORD4XPROC)(GLenum, GLfixed, GLfixed, GLfixed, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLNORMAL3FPROC)(GLfloat, GLfloat, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLNORMAL3XPROC)(GLfixed, GLfixed, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLNORMALPOINTERPROC)(GLenum, GLsizei, const void *);
+typedef void  (GLAPIENTRY *PFNGLORTHOFPROC)(GLfloat, GLfloat, GLfloat, GLfloat, GLfloat, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLORTHOXPROC)(GLfixed, GLfixed, GLfixed, GLfixed, GLfixed, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLPIXELSTOREIPROC)(GLenum, GLint);
+typedef void  (GLAPIENTRY *PFNGLPOINTPARAMETERFPROC)(GLenum, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLPOINTPARAMETERFVPROC)(GLenum, const GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLPOINTPARAMETERXPROC)(GLenum, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLPOINTPARAMETERXVPROC)(GLenum, const GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLPOINTSIZEPROC)(GLfloat);
+typedef void  (GLAPIENTRY *PFNGLPOINTSIZEXPROC)(GLfixed);
+typedef void  (GLAPIENTRY *PFNGLPOLYGONOFFSETPROC)(GLfloat, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLPOLYGONOFFSETXPROC)(GLfixed, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLPOPMATRIXPROC)(void);
+typedef void  (GLAPIENTRY *PFNGLPUSHMATRIXPROC)(void);
+typedef void  (GLAPIENTRY *PFNGLREADPIXELSPROC)(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void *);
+typedef void  (GLAPIENTRY *PFNGLROTATEFPROC)(GLfloat, GLfloat, GLfloat, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLROTATEXPROC)(GLfixed, GLfixed, GLfixed, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLSAMPLECOVERAGEPROC)(GLfloat, GLboolean);
+typedef void  (GLAPIENTRY *PFNGLSAMPLECOVERAGEXPROC)(GLclampx, GLboolean);
+typedef void  (GLAPIENTRY *PFNGLSCALEFPROC)(GLfloat, GLfloat, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLSCALEXPROC)(GLfixed, GLfixed, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLSCISSORPROC)(GLint, GLint, GLsizei, GLsizei);
+typedef void  (GLAPIENTRY *PFNGLSHADEMODELPROC)(GLenum);
+typedef void  (GLAPIENTRY *PFNGLSTENCILFUNCPROC)(GLenum, GLint, GLuint);
+typedef void  (GLAPIENTRY *PFNGLSTENCILMASKPROC)(GLuint);
+typedef void  (GLAPIENTRY *PFNGLSTENCILOPPROC)(GLenum, GLenum, GLenum);
+typedef void  (GLAPIENTRY *PFNGLTEXCOORDPOINTERPROC)(GLint, GLenum, GLsizei, const void *);
+typedef void  (GLAPIENTRY *PFNGLTEXENVFPROC)(GLenum, GLenum, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLTEXENVFVPROC)(GLenum, GLenum, const GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLTEXENVIPROC)(GLenum, GLenum, GLint);
+typedef void  (GLAPIENTRY *PFNGLTEXENVIVPROC)(GLenum, GLenum, const GLint *);
+typedef void  (GLAPIENTRY *PFNGLTEXENVXPROC)(GLenum, GLenum, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLTEXENVXVPROC)(GLenum, GLenum, const GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLTEXIMAGE2DPROC)(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void *);
+typedef void  (GLAPIENTRY *PFNGLTEXPARAMETERFPROC)(GLenum, GLenum, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLTEXPARAMETERFVPROC)(GLenum, GLenum, const GLfloat *);
+typedef void  (GLAPIENTRY *PFNGLTEXPARAMETERIPROC)(GLenum, GLenum, GLint);
+typedef void  (GLAPIENTRY *PFNGLTEXPARAMETERIVPROC)(GLenum, GLenum, const GLint *);
+typedef void  (GLAPIENTRY *PFNGLTEXPARAMETERXPROC)(GLenum, GLenum, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLTEXPARAMETERXVPROC)(GLenum, GLenum, const GLfixed *);
+typedef void  (GLAPIENTRY *PFNGLTEXSUBIMAGE2DPROC)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void *);
+typedef void  (GLAPIENTRY *PFNGLTRANSLATEFPROC)(GLfloat, GLfloat, GLfloat);
+typedef void  (GLAPIENTRY *PFNGLTRANSLATEXPROC)(GLfixed, GLfixed, GLfixed);
+typedef void  (GLAPIENTRY *PFNGLVERTEXPOINTERPROC)(GLint, GLenum, GLsizei, const void *);
+typedef void  (GLAPIENTRY *PFNGLVIEWPORTPROC)(GLint, GLint, GLsizei, GLsizei);
+
+/* OpenGL ES macros */
+#define glActiveTexture ((PFNGLACTIVETEXTUREPROC) GREG_PROCS[0])
+#define glAlphaFunc ((PFNGLALPHAFUNCPROC) GREG_PROCS[1])
+#define glAlphaFuncx ((PFNGLALPHAFUNCXPROC) GREG_PROCS[2])
+#define glBindBuffer ((PFNGLBINDBUFFERPROC) GREG_PROCS[3])
+#define glBindTexture ((PFNGLBINDTEXTUREPROC) GREG_PROCS[4])
+#define glBlendFunc ((PFNGLBLENDFUNCPROC) GREG_PROCS[5])
+#define glBufferData ((PFNGLBUFFERDATAPROC) GREG_PROCS[6])
+#define glBufferSubData ((PFNGLBUFFERSUBDATAPROC) GREG_PROCS[7])
+#define glClear ((PFNGLCLEARPROC) GREG_PROCS[8])
+#define glClearColor ((PFNGLCLEARCOLORPROC) GREG_PROCS[9])
+#define glClearColorx ((PFNGLCLEARCOLORXPROC) GREG_PROCS[10])
+#define glClearDepthf ((PFNGLCLEARDEPTHFPROC) GREG_PROCS[11])
+#define glClearDepthx ((PFNGLCLEARDEPTHXPROC) GREG_PROCS[12])
+#define glClearStencil ((PFNGLCLEARSTENCILPROC) GREG_PROCS[13])
+#define glClientActiveTexture ((PFNGLCLIENTACTIVETEXTUREPROC) GREG_PROCS[14])
+#define glClipPlanef ((PFNGLCLIPPLANEFPROC) GREG_PROCS[15])
+#define glClipPlanex ((PFNGLCLIPPLANEXPROC) GREG_PROCS[16])
+#define glColor4f ((PFNGLCOLOR4FPROC) GREG_PROCS[17])
+#define glColor4ub ((PFNGLCOLOR4UBPROC) GREG_PROCS[18])
+#define glColor4x ((PFNGLCOLOR4XPROC) GREG_PROCS[19])
+#define glColorMask ((PFNGLCOLORMASKPROC) GREG_PROCS[20])
+#define glColorPointer ((PFNGLCOLORPOINTERPROC) GREG_PROCS[21])
+#define glCompressedTexImage2D ((PFNGLCOMPRESSEDTEXIMAGE2DPROC) GREG_PROCS[22])
+#define glCompressedTexSubImage2D ((PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC) GREG_PROCS[23])
+#define glCopyTexImage2D ((PFNGLCOPYTEXIMAGE2DPROC) GREG_PROCS[24])
+#define glCopyTexSubImage2D ((PFNGLCOPYTEXSUBIMAGE2DPROC) GREG_PROCS[25])
+#define glCullFace ((PFNGLCULLFACEPROC) GREG_PROCS[26])
+#define glDeleteBuffers ((PFNGLDELETEBUFFERSPROC) GREG_PROCS[27])
+#define glDeleteTextures ((PFNGLDELETETEXTURESPROC) GREG_PROCS[28])
+#define glDepthFunc ((PFNGLDEPTHFUNCPROC) GREG_PROCS[29])
+#define glDepthMask ((PFNGLDEPTHMASKPROC) GREG_PROCS[30])
+#define glDepthRangef ((PFNGLDEPTHRANGEFPROC) GREG_PROCS[31])
+#define glDepthRangex ((PFNGLDEPTHRANGEXPROC) GREG_PROCS[32])
+#define glDisable ((PFNGLDISABLEPROC) GREG_PROCS[33])
+#define glDisableClientState ((PFNGLDISABLECLIENTSTATEPROC) GREG_PROCS[34])
+#define glDrawArrays ((PFNGLDRAWARRAYSPROC) GREG_PROCS[35])
+#define glDrawElements ((PFNGLDRAWELEMENTSPROC) GREG_PROCS[36])
+#define glEnable ((PFNGLENABLEPROC) GREG_PROCS[37])
+#define glEnableClientState ((PFNGLENABLECLIENTSTATEPROC) GREG_PROCS[38])
+#define glFinish ((PFNGLFINISHPROC) GREG_PROCS[39])
+#define glFlush ((PFNGLFLUSHPROC) GREG_PROCS[40])
+#define glFogf ((PFNGLFOGFPROC) GREG_PROCS[41])
+#define glFogfv ((PFNGLFOGFVPROC) GREG_PROCS[42])
+#define glFogx ((PFNGLFOGXPROC) GREG_PROCS[43])
+#define glFogxv ((PFNGLFOGXVPROC) GREG_PROCS[44])
+#define glFrontFace ((PFNGLFRONTFACEPROC) GREG_PROCS[45])
+#define glFrustumf ((PFNGLFRUSTUMFPROC) GREG_PROCS[46])
+#define glFrustumx ((PFNGLFRUSTUMXPROC) GREG_PROCS[47])
+#define glGenBuffers ((PFNGLGENBUFFERSPROC) GREG_PROCS[48])
+#define glGenTextures ((PFNGLGENTEXTURESPROC) GREG_PROCS[49])
+#define glGetBooleanv ((PFNGLGETBOOLEANVPROC) GREG_PROCS[50])
+#define glGetBufferParameteriv ((PFNGLGETBUFFERPARAMETERIVPROC) GREG_PROCS[51])
+#define glGetClipPlanef ((PFNGLGETCLIPPLANEFPROC) GREG_PROCS[52])
+#define glGetClipPlanex ((PFNGLGETCLIPPLANEXPROC) GREG_PROCS[53])
+#define glGetError ((PFNGLGETERRORPROC) GREG_PROCS[54])
+#define glGetFixedv ((PFNGLGETFIXEDVPROC) GREG_PROCS[55])
+#define glGetFloatv ((PFNGLGETFLOATVPROC) GREG_PROCS[56])
+#define glGetIntegerv ((PFNGLGETINTEGERVPROC) GREG_PROCS[57])
+#define glGetLightfv ((PFNGLGETLIGHTFVPROC) GREG_PROCS[58])
+#define glGetLightxv ((PFNGLGETLIGHTXVPROC) GREG_PROCS[59])
+#define glGetMaterialfv ((PFNGLGETMATERIALFVPROC) GREG_PROCS[60])
+#define glGetMaterialxv ((PFNGLGETMATERIALXVPROC) GREG_PROCS[61])
+#define glGetPointerv ((PFNGLGETPOINTERVPROC) GREG_PROCS[62])
+#define glGetString ((PFNGLGETSTRINGPROC) GREG_PROCS[63])
+#define glGetTexEnvfv ((PFNGLGETTEXENVFVPROC) GREG_PROCS[64])
+#define glGetTexEnviv ((PFNGLGETTEXENVIVPROC) GREG_PROCS[65])
+#define glGetTexEnvxv ((PFNGLGETTEXENVXVPROC) GREG_PROCS[66])
+#define glGetTexParameterfv ((PFNGLGETTEXPARAMETERFVPROC) GREG_PROCS[67])
+#define glGetTexParameteriv ((PFNGLGETTEXPARAMETERIVPROC) GREG_PROCS[68])
+#define glGetTexParameterxv ((PFNGLGETTEXPARAMETERXVPROC) GREG_PROCS[69])
+#define glHint ((PFNGLHINTPROC) GREG_PROCS[70])
+#define glIsBuffer ((PFNGLISBUFFERPROC) GREG_PROCS[71])
+#define glIsEnabled ((PFNGLISENABLEDPROC) GREG_PROCS[72])
+#define glIsTexture ((PFNGLISTEXTUREPROC) GREG_PROCS[73])
+#define glLightModelf ((PFNGLLIGHTMODELFPROC) GREG_PROCS[74])
+#define glLightModelfv ((PFNGLLIGHTMODELFVPROC) GREG_PROCS[75])
+#define glLightModelx ((PFNGLLIGHTMODELXPROC) GREG_PROCS[76])
+#define glLightModelxv ((PFNGLLIGHTMODELXVPROC) GREG_PROCS[77])
+#define glLightf ((PFNGLLIGHTFPROC) GREG_PROCS[78])
+#define glLightfv ((PFNGLLIGHTFVPROC) GREG_PROCS[79])
+#define glLightx ((PFNGLLIGHTXPROC) GREG_PROCS[80])
+#define glLightxv ((PFNGLLIGHTXVPROC) GREG_PROCS[81])
+#define glLineWidth ((PFNGLLINEWIDTHPROC) GREG_PROCS[82])
+#define glLineWidthx ((PFNGLLINEWIDTHXPROC) GREG_PROCS[83])
+#define glLoadIdentity ((PFNGLLOADIDENTITYPROC) GREG_PROCS[84])
+#define glLoadMatrixf ((PFNGLLOADMATRIXFPROC) GREG_PROCS[85])
+#define glLoadMatrixx ((PFNGLLOADMATRIXXPROC) GREG_PROCS[86])
+#define glLogicOp ((PFNGLLOGICOPPROC) GREG_PROCS[87])
+#define glMaterialf ((PFNGLMATERIALFPROC) GREG_PROCS[88])
+#define glMaterialfv ((PFNGLMATERIALFVPROC) GREG_PROCS[89])
+#define glMaterialx ((PFNGLMATERIALXPROC) GREG_PROCS[90])
+#define glMaterialxv ((PFNGLMATERIALXVPROC) GREG_PROCS[91])
+#define glMatrixMode ((PFNGLMATRIXMODEPROC) GREG_PROCS[92])
+#define glMultMatrixf ((PFNGLMULTMATRIXFPROC) GREG_PROCS[93])
+#define glMultMatrixx ((PFNGLMULTMATRIXXPROC) GREG_PROCS[94])
+#define glMultiTexCoord4f ((PFNGLMULTITEXCOORD4FPROC) GREG_PROCS[95])
+#define glMultiTexCoord4x ((PFNGLMULTITEXCOORD4XPROC) GREG_PROCS[96])
+#define glNormal3f ((PFNGLNORMAL3FPROC) GREG_PROCS[97])
+#define glNormal3x ((PFNGLNORMAL3XPROC) GREG_PROCS[98])
+#define glNormalPointer ((PFNGLNORMALPOINTERPROC) GREG_PROCS[99])
+#define glOrthof ((PFNGLORTHOFPROC) GREG_PROCS[100])
+#define glOrthox ((PFNGLORTHOXPROC) GREG_PROCS[101])
+#define glPixelStorei ((PFNGLPIXELSTOREIPROC) GREG_PROCS[102])
+#define glPointParameterf ((PFNGLPOINTPARAMETERFPROC) GREG_PROCS[103])
+#define glPointParameterfv ((PFNGLPOINTPARAMETERFVPROC) GREG_PROCS[104])
+#define glPointParameterx ((PFNGLPOINTPARAMETERXPROC) GREG_PROCS[105])
+#define glPointParameterxv ((PFNGLPOINTPARAMETERXVPROC) GREG_PROCS[106])
+#define glPointSize ((PFNGLPOINTSIZEPROC) GREG_PROCS[107])
+#define glPointSizex ((PFNGLPOINTSIZEXPROC) GREG_PROCS[108])
+#define glPolygonOffset ((PFNGLPOLYGONOFFSETPROC) GREG_PROCS[109])
+#define glPolygonOffsetx ((PFNGLPOLYGONOFFSETXPROC) GREG_PROCS[110])
+#define glPopMatrix ((PFNGLPOPMATRIXPROC) GREG_PROCS[111])
+#define glPushMatrix ((PFNGLPUSHMATRIXPROC) GREG_PROCS[112])
+#define glReadPixels ((PFNGLREADPIXELSPROC) GREG_PROCS[113])
+#define glRotatef ((PFNGLROTATEFPROC) GREG_PROCS[114])
+#define glRotatex ((PFNGLROTATEXPROC) GREG_PROCS[115])
+#define glSampleCoverage ((PFNGLSAMPLECOVERAGEPROC) GREG_PROCS[116])
+#define glSampleCoveragex ((PFNGLSAMPLECOVERAGEXPROC) GREG_PROCS[117])
+#define glScalef ((PFNGLSCALEFPROC) GREG_PROCS[118])
+#define glScalex ((PFNGLSCALEXPROC) GREG_PROCS[119])
+#define glScissor ((PFNGLSCISSORPROC) GREG_PROCS[120])
+#define glShadeModel ((PFNGLSHADEMODELPROC) GREG_PROCS[121])
+#define glStencilFunc ((PFNGLSTENCILFUNCPROC) GREG_PROCS[122])
+#define glStencilMask ((PFNGLSTENCILMASKPROC) GREG_PROCS[123])
+#define glStencilOp ((PFNGLSTENCILOPPROC) GREG_PROCS[124])
+#define glTexCoordPointer ((PFNGLTEXCOORDPOINTERPROC) GREG_PROCS[125])
+#define glTexEnvf ((PFNGLTEXENVFPROC) GREG_PROCS[126])
+#define glTexEnvfv ((PFNGLTEXENVFVPROC) GREG_PROCS[127])
+#define glTexEnvi ((PFNGLTEXENVIPROC) GREG_PROCS[128])
+#define glTexEnviv ((PFNGLTEXENVIVPROC) GREG_PROCS[129])
+#define glTexEnvx ((PFNGLTEXENVXPROC) GREG_PROCS[130])
+#define glTexEnvxv ((PFNGLTEXENVXVPROC) GREG_PROCS[131])
+#define glTexImage2D ((PFNGLTEXIMAGE2DPROC) GREG_PROCS[132])
+#define glTexParameterf ((PFNGLTEXPARAMETERFPROC) GREG_PROCS[133])
+#define glTexParameterfv ((PFNGLTEXPARAMETERFVPROC) GREG_PROCS[134])
+#define glTexParameteri ((PFNGLTEXPARAMETERIPROC) GREG_PROCS[135])
+#define glTexParameteriv ((PFNGLTEXPARAMETERIVPROC) GREG_PROCS[136])
+#define glTexParameterx ((PFNGLTEXPARAMETERXPROC) GREG_PROCS[137])
+#define glTexParameterxv ((PFNGLTEXPARAMETERXVPROC) GREG_PROCS[138])
+#define glTexSubImage2D ((PFNGLTEXSUBIMAGE2DPROC) GREG_PROCS[139])
+#define glTranslatef ((PFNGLTRANSLATEFPROC) GREG_PROCS[140])
+#define glTranslatex ((PFNGLTRANSLATEXPROC) GREG_PROCS[141])
+#define glVertexPointer ((PFNGLVERTEXPOINTERPROC) GREG_PROCS[142])
+#define glViewport ((PFNGLVIEWPORTPROC) GREG_PROCS[143])
+
+
+#if defined(GREG_MULTI_CONTEXT)
+/* Initializes the specified context from the OpenGL ES context current on the
+ * calling thread and makes it the current context of that thread
+ */
+GREGDEF int gregInitContext(GregContext* context);
+
+/* Makes the specified context the current context of the calling thread
+ */
+GREGDEF void gregMakeCurrent(GregContext* context);
+#else
+/* Initializes the library
+ */
+GREGDEF int gregInit(void);
+#endif
+
+/* Updates the current context for a lost or recreated OpenGL ES context,
+ * querying the version and extensions again and sets changed, if not NULL,
+ * to whether the supported versions and extensions differ from before
+ * Functions are only loaded again if that set changed or they may depend on
+ * the context, as with WGL
+ */
+GREGDEF int gregReinit(int* changed);
+
+/* Frees the OpenGL ES library kept loaded since initialization
+ */
+GREGDEF void gregTerminate(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _greg_h_ */
+
+#ifdef GREG_IMPLEMENTATION
+
+#include <string.h>
+#include <stdio.h>
+
+#if defined(GREG_USE_EGL)
+ #include <EGL/egl.h>
+#elif defined(GREG_USE_GLFW3)
+ #include <GLFW/glfw3.h>
+#elif defined(GREG_USE_SDL2)
+ #include <SDL/SDL.h>
+#elif defined(_WIN32)
+ #include <windows.h>
+#elif defined(__linux__)
+ #include <GL/glx.h>
+#elif defined(__APPLE__)
+ #include <CoreFoundation/CoreFoundation.h>
+ #include <OpenGL/OpenGL.h>
+#endif
+
+/* Look up core functions directly in the library where it isn't already
+ * linked by the backend */
+#if defined(__linux__) && !defined(GREG_USE_GLFW3) && !defined(GREG_USE_SDL2)
+ #define _GREG_DLOPEN
+ #include <dlfcn.h>
+#endif
+
+/* Function pointers from wglGetProcAddress may differ between contexts, so
+ * they are looked up again when reinitializing */
+#if defined(_WIN32) && !defined(GREG_USE_EGL)
+ #define _GREG_CONTEXT_PROCS
+#endif
+
+static struct
+{
+    GLboolean loaded;
+
+#if !defined(GREG_MULTI_CONTEXT)
+    struct
+    {
+        int major;
+        int minor;
+    } version;
+#endif
+
+#if defined(GREG_USE_EGL)
+#elif defined(GREG_USE_GLFW3)
+#elif defined(GREG_USE_SDL2)
+#elif defined(_WIN32)
+    struct
+    {
+        HINSTANCE instance;
+    } wgl;
+#elif defined(__APPLE__)
+    struct
+    {
+        void* framework;
+    } nsgl;
+#endif
+
+#if defined(_GREG_DLOPEN)
+    struct
+    {
+        void* handle;
+    } dl;
+#endif
+
+} _greg;
+
+#if defined(GREG_MULTI_CONTEXT)
+/* The current context of each thread */
+GREGDEF GREG_THREAD_LOCAL GregContext* greg_context = NULL;
+
+ #define _greg_version greg_context->version
+#else
+/* OpenGL ES version and extension booleans */
+GREGDEF int greg_booleans[1] = { 0 };
+/* OpenGL ES version and extension booleans as a set of bits */
+GREGDEF GregCapabilities greg_capabilities = { { 0 } };
+/* OpenGL ES function pointers */
+GREGDEF GREG_CACHE_ALIGNED GREGproc greg_procs[144] = { NULL };
+
+ #define _greg_version _greg.version
+#endif
+
+/* OpenGL ES extension names, at the same indices as their booleans */
+#define GREG_EXTENSION_COUNT 0
+
+/* OpenGL ES function names, at the same indices as their pointers */
+static const char greg_names[] =
+    "glActiveTexture\0"
+    "glAlphaFunc\0"
+    "glAlphaFuncx\0"
+    "glBindBuffer\0"
+    "glBindTexture\0"
+    "glBlendFunc\0"
+    "glBufferData\0"
+    "glBufferSubData\0"
+    "glClear\0"
+    "glClearColor\0"
+    "glClearColorx\0"
+    "glClearDepthf\0"
+    "glClearDepthx\0"
+    "glClearStencil\0"
+    "glClientActiveTexture\0"
+    "glClipPlanef\0"
+    "glClipPlanex\0"
+    "glColor4f\0"
+    "glColor4ub\0"
+    "glColor4x\0"
+    "glColorMask\0"
+    "glColorPointer\0"
+    "glCompressedTexImage2D\0"
+    "glCompressedTexSubImage2D\0"
+    "glCopyTexImage2D\0"
+    "glCopyTexSubImage2D\0"
+    "glCullFace\0"
+    "glDeleteBuffers\0"
+    "glDeleteTextures\0"
+    "glDepthFunc\0"
+    "glDepthMask\0"
+    "glDepthRangef\0"
+    "glDepthRangex\0"
+    "glDisable\0"
+    "glDisableClientState\0"
+    "glDrawArrays\0"
+    "glDrawElements\0"
+    "glEnable\0"
+    "glEnableClientState\0"
+    "glFinish\0"
+    "glFlush\0"
+    "glFogf\0"
+    "glFogfv\0"
+    "glFogx\0"
+    "glFogxv\0"
+    "glFrontFace\0"
+    "glFrustumf\0"
+    "glFrustumx\0"
+    "glGenBuffers\0"
+    "glGenTextures\0"
+    "glGetBooleanv\0"
+    "glGetBufferParameteriv\0"
+    "glGetClipPlanef\0"
+    "glGetClipPlanex\0"
+    "glGetError\0"
+    "glGetFixedv\0"
+    "glGetFloatv\0"
+    "glGetIntegerv\0"
+    "glGetLightfv\0"
+    "glGetLightxv\0"
+    "glGetMaterialfv\0"
+    "glGetMaterialxv\0"
+    "glGetPointerv\0"
+    "glGetString\0"
+    "glGetTexEnvfv\0"
+    "glGetTexEnviv\0"
+    "glGetTexEnvxv\0"
+    "glGetTexParameterfv\0"
+    "glGetTexParameteriv\0"
+    "glGetTexParameterxv\0"
+    "glHint\0"
+    "glIsBuffer\0"
+    "glIsEnabled\0"
+    "glIsTexture\0"
+    "glLightModelf\0"
+    "glLightModelfv\0"
+    "glLightModelx\0"
+    "glLightModelxv\0"
+    "glLightf\0"
+    "glLightfv\0"
+    "glLightx\0"
+    "glLightxv\0"
+    "glLineWidth\0"
+    "glLineWidthx\0"
+    "glLoadIdentity\0"
+    "glLoadMatrixf\0"
+    "glLoadMatrixx\0"
+    "glLogicOp\0"
+    "glMaterialf\0"
+    "glMaterialfv\0"
+    "glMaterialx\0"
+    "glMaterialxv\0"
+    "glMatrixMode\0"
+    "glMultMatrixf\0"
+    "glMultMatrixx\0"
+    "glMultiTexCoord4f\0"
+    "glMultiTexCoord4x\0"
+    "glNormal3f\0"
+    "glNormal3x\0"
+    "glNormalPointer\0"
+    "glOrthof\0"
+    "glOrthox\0"
+    "glPixelStorei\0"
+    "glPointParameterf\0"
+    "glPointParameterfv\0"
+    "glPointParameterx\0"
+    "glPointParameterxv\0"
+    "glPointSize\0"
+    "glPointSizex\0"
+    "glPolygonOffset\0"
+    "glPolygonOffsetx\0"
+    "glPopMatrix\0"
+    "glPushMatrix\0"
+    "glReadPixels\0"
+    "glRotatef\0"
+    "glRotatex\0"
+    "glSampleCoverage\0"
+    "glSampleCoveragex\0"
+    "glScalef\0"
+    "glScalex\0"
+    "glScissor\0"
+    "glShadeModel\0"
+    "glStencilFunc\0"
+    "glStencilMask\0"
+    "glStencilOp\0"
+    "glTexCoordPointer\0"
+    "glTexEnvf\0"
+    "glTexEnvfv\0"
+    "glTexEnvi\0"
+    "glTexEnviv\0"
+    "glTexEnvx\0"
+    "glTexEnvxv\0"
+    "glTexImage2D\0"
+    "glTexParameterf\0"
+    "glTexParameterfv\0"
+    "glTexParameteri\0"
+    "glTexParameteriv\0"
+    "glTexParameterx\0"
+    "glTexParameterxv\0"
+    "glTexSubImage2D\0"
+    "glTranslatef\0"
+    "glTranslatex\0"
+    "glVertexPointer\0"
+    "glViewport\0";
+
+static const unsigned short greg_offsets[] =
+{
+    0, 16, 28, 41, 54, 68, 80, 93, 109, 117,
+    130, 144, 158, 172, 187, 209, 222, 235, 245, 256,
+    266, 278, 293, 316, 342, 359, 379, 390, 406, 423,
+    435, 447, 461, 475, 485, 506, 519, 534, 543, 563,
+    572, 580, 587, 595, 602, 610, 622, 633, 644, 657,
+    671, 685, 708, 724, 740, 751, 763, 775, 789, 802,
+    815, 831, 847, 861, 873, 887, 901, 915, 935, 955,
+    975, 982, 993, 1005, 1017, 1031, 1046, 1060, 1075, 1084,
+    1094, 1103, 1113, 1125, 1138, 1153, 1167, 1181, 1191, 1203,
+    1216, 1228, 1241, 1254, 1268, 1282, 1300, 1318, 1329, 1340,
+    1356, 1365, 1374, 1388, 1406, 1425, 1443, 1462, 1474, 1487,
+    1503, 1520, 1532, 1545, 1558, 1568, 1578, 1595, 1613, 1622,
+    1631, 1641, 1654, 1668, 1682, 1694, 1712, 1722, 1733, 1743,
+    1754, 1764, 1775, 1788, 1804, 1821, 1837, 1854, 1870, 1887,
+    1903, 1916, 1929, 1945, 1956,
+};
+
+
+/* Checks whether an OpenGL ES or context is current
+ */
+static GLboolean gregHasContext(void)
+{
+#if defined(GREG_USE_EGL)
+    return eglGetCurrentContext() != EGL_NO_CONTEXT;
+#elif defined(GREG_USE_GLFW3)
+    return glfwGetCurrentContext() != NULL;
+#elif defined(GREG_USE_SDL2)
+    return SDL_GL_GetCurrentContext() != NULL;
+#elif defined(_WIN32)
+    return wglGetCurrentContext() != NULL;
+#elif defined(__linux__)
+    return glXGetCurrentContext() != NULL;
+#elif defined(__APPLE__)
+    return CGLGetCurrentContext() != NULL;
+#endif
+}
+
+/* Loads the OpenGL ES library for function pointer discovery
+ * The library stays loaded until gregTerminate is called
+ */
+static GLboolean gregLoadLibrary(void)
+{
+#if defined(_GREG_DLOPEN)
+    static const char* names[] =
+    {
+ #if defined(GL_ES_VERSION_2_0)
+        "libGLESv2.so.2",
+ #elif defined(GL_VERSION_ES_CM_1_0)
+        "libGLESv1_CM.so.1",
+ #elif defined(GREG_USE_EGL)
+        "libOpenGL.so.0",
+        "libGL.so.1",
+ #else
+        "libGL.so.1",
+ #endif
+        NULL
+    };
+    int i;
+#endif
+
+    if (_greg.loaded)
+        return GL_TRUE;
+
+#if defined(GREG_USE_EGL)
+#elif defined(GREG_USE_GLFW3)
+#elif defined(GREG_USE_SDL2)
+    if (SDL_GL_LoadLibrary(NULL) != 0)
+        return GL_FALSE;
+#elif defined(_WIN32)
+    _greg.wgl.instance = LoadLibraryA("opengl32.dll");
+    if (!_greg.wgl.instance)
+        return GL_FALSE;
+#elif defined(__linux__)
+#elif defined(__APPLE__)
+    _greg.nsgl.framework = CFBundleGetBundleWithIdentifier(CFSTR("com.apple.opengl"));
+    if (!_greg.nsgl.framework)
+        return GL_FALSE;
+
+    /* The bundle is not owned by the caller of CFBundleGetBundleWithIdentifier */
+    CFRetain(_greg.nsgl.framework);
+#endif
+
+#if defined(_GREG_DLOPEN)
+    /* The backend is still used for functions the library doesn't export */
+    for (i = 0;  names[i] && !_greg.dl.handle;  i++)
+        _greg.dl.handle = dlopen(names[i], RTLD_LAZY | RTLD_LOCAL);
+#endif
+
+    _greg.loaded = GL_TRUE;
+    return GL_TRUE;
+}
+
+/* Frees the loaded OpenGL ES library
+ */
+static void gregFreeLibrary(void)
+{
+    if (!_greg.loaded)
+        return;
+
+#if defined(GREG_USE_EGL)
+#elif defined(GREG_USE_GLFW3)
+#elif defined(GREG_USE_SDL2)
+    SDL_GL_UnloadLibrary();
+#elif defined(_WIN32)
+    if (_greg.wgl.instance)
+        FreeLibrary(_greg.wgl.instance);
+#elif defined(__linux__)
+#elif defined(__APPLE__)
+    if (_greg.nsgl.framework)
+        CFRelease(_greg.nsgl.framework);
+#endif
+
+#if defined(_GREG_DLOPEN)
+    if (_greg.dl.handle)
+        dlclose(_greg.dl.handle);
+#endif
+
+    memset(&_greg, 0, sizeof(_greg));
+}
+
+/* Returns the address of the requested OpenGL ES function
+ * Functions exported by the library are looked up there first
+ */
+static GREGproc gregGetProcAddress(const char* name)
+{
+    GREGproc proc;
+
+#if defined(_GREG_DLOPEN)
+    if (_greg.dl.handle)
+    {
+        proc = (GREGproc) dlsym(_greg.dl.handle, name);
+        if (proc)
+            return proc;
+    }
+#endif
+
+#if defined(GREG_USE_EGL)
+    proc = (GREGproc) eglGetProcAddress(name);
+#elif defined(GREG_USE_GLFW3)
+    proc = (GREGproc) glfwGetProcAddress(name);
+#elif defined(GREG_USE_SDL2)
+    proc = (GREGproc) SDL_GL_GetProcAddress(name);
+#elif defined(_WIN32)
+    proc = (GREGproc) GetProcAddress(_greg.wgl.instance, name);
+    if (!proc)
+        proc = (GREGproc) wglGetProcAddress(name);
+#elif defined(__linux__)
+    proc = (GREGproc) glXGetProcAddress((const GLubyte*) name);
+#elif defined(__APPLE__)
+    CFStringRef native = CFStringCreateWithCString(kCFAllocatorDefault, name, kCFStringEncodingASCII);
+    proc = (GREGproc) CFBundleGetFunctionPointerForName(_greg.nsgl.framework, native);
+    CFRelease(native);
+#endif
+
+    return proc;
+}
+
+/* Returns the address of the command at the specified index of the function
+ * pointer table, trying each name of the entry until one is found
+ */
+static GREGproc gregGetCommandAddress(size_t index)
+{
+    const char* name = greg_names + greg_offsets[index];
+    GREGproc proc = NULL;
+
+    while (!proc && name < greg_names + greg_offsets[index + 1])
+    {
+        proc = gregGetProcAddress(name);
+        name += strlen(name) + 1;
+    }
+
+    return proc;
+}
+
+#if defined(GREG_LAZY)
+/* Resolves the command at the specified index of the function pointer table
+ * This replaces the trampoline in the table with the command itself
+ */
+static GREGproc gregResolveCommand(size_t index)
+{
+    GREG_PROCS[index] = gregGetCommandAddress(index);
+    return GREG_PROCS[index];
+}
+
+/* OpenGL ES lazy binding trampolines */
+static void  GLAPIENTRY gregLazy_glActiveTexture(GLenum p0)
+{
+    ((PFNGLACTIVETEXTUREPROC) gregResolveCommand(0))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glAlphaFunc(GLenum p0, GLfloat p1)
+{
+    ((PFNGLALPHAFUNCPROC) gregResolveCommand(1))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glAlphaFuncx(GLenum p0, GLfixed p1)
+{
+    ((PFNGLALPHAFUNCXPROC) gregResolveCommand(2))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glBindBuffer(GLenum p0, GLuint p1)
+{
+    ((PFNGLBINDBUFFERPROC) gregResolveCommand(3))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glBindTexture(GLenum p0, GLuint p1)
+{
+    ((PFNGLBINDTEXTUREPROC) gregResolveCommand(4))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glBlendFunc(GLenum p0, GLenum p1)
+{
+    ((PFNGLBLENDFUNCPROC) gregResolveCommand(5))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glBufferData(GLenum p0, GLsizeiptr p1, const void *p2, GLenum p3)
+{
+    ((PFNGLBUFFERDATAPROC) gregResolveCommand(6))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glBufferSubData(GLenum p0, GLintptr p1, GLsizeiptr p2, const void *p3)
+{
+    ((PFNGLBUFFERSUBDATAPROC) gregResolveCommand(7))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glClear(GLbitfield p0)
+{
+    ((PFNGLCLEARPROC) gregResolveCommand(8))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glClearColor(GLfloat p0, GLfloat p1, GLfloat p2, GLfloat p3)
+{
+    ((PFNGLCLEARCOLORPROC) gregResolveCommand(9))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glClearColorx(GLfixed p0, GLfixed p1, GLfixed p2, GLfixed p3)
+{
+    ((PFNGLCLEARCOLORXPROC) gregResolveCommand(10))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glClearDepthf(GLfloat p0)
+{
+    ((PFNGLCLEARDEPTHFPROC) gregResolveCommand(11))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glClearDepthx(GLfixed p0)
+{
+    ((PFNGLCLEARDEPTHXPROC) gregResolveCommand(12))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glClearStencil(GLint p0)
+{
+    ((PFNGLCLEARSTENCILPROC) gregResolveCommand(13))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glClientActiveTexture(GLenum p0)
+{
+    ((PFNGLCLIENTACTIVETEXTUREPROC) gregResolveCommand(14))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glClipPlanef(GLenum p0, const GLfloat *p1)
+{
+    ((PFNGLCLIPPLANEFPROC) gregResolveCommand(15))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glClipPlanex(GLenum p0, const GLfixed *p1)
+{
+    ((PFNGLCLIPPLANEXPROC) gregResolveCommand(16))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glColor4f(GLfloat p0, GLfloat p1, GLfloat p2, GLfloat p3)
+{
+    ((PFNGLCOLOR4FPROC) gregResolveCommand(17))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glColor4ub(GLubyte p0, GLubyte p1, GLubyte p2, GLubyte p3)
+{
+    ((PFNGLCOLOR4UBPROC) gregResolveCommand(18))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glColor4x(GLfixed p0, GLfixed p1, GLfixed p2, GLfixed p3)
+{
+    ((PFNGLCOLOR4XPROC) gregResolveCommand(19))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glColorMask(GLboolean p0, GLboolean p1, GLboolean p2, GLboolean p3)
+{
+    ((PFNGLCOLORMASKPROC) gregResolveCommand(20))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glColorPointer(GLint p0, GLenum p1, GLsizei p2, const void *p3)
+{
+    ((PFNGLCOLORPOINTERPROC) gregResolveCommand(21))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glCompressedTexImage2D(GLenum p0, GLint p1, GLenum p2, GLsizei p3, GLsizei p4, GLint p5, GLsizei p6, const void *p7)
+{
+    ((PFNGLCOMPRESSEDTEXIMAGE2DPROC) gregResolveCommand(22))(p0, p1, p2, p3, p4, p5, p6, p7);
+}
+
+static void  GLAPIENTRY gregLazy_glCompressedTexSubImage2D(GLenum p0, GLint p1, GLint p2, GLint p3, GLsizei p4, GLsizei p5, GLenum p6, GLsizei p7, const void *p8)
+{
+    ((PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC) gregResolveCommand(23))(p0, p1, p2, p3, p4, p5, p6, p7, p8);
+}
+
+static void  GLAPIENTRY gregLazy_glCopyTexImage2D(GLenum p0, GLint p1, GLenum p2, GLint p3, GLint p4, GLsizei p5, GLsizei p6, GLint p7)
+{
+    ((PFNGLCOPYTEXIMAGE2DPROC) gregResolveCommand(24))(p0, p1, p2, p3, p4, p5, p6, p7);
+}
+
+static void  GLAPIENTRY gregLazy_glCopyTexSubImage2D(GLenum p0, GLint p1, GLint p2, GLint p3, GLint p4, GLint p5, GLsizei p6, GLsizei p7)
+{
+    ((PFNGLCOPYTEXSUBIMAGE2DPROC) gregResolveCommand(25))(p0, p1, p2, p3, p4, p5, p6, p7);
+}
+
+static void  GLAPIENTRY gregLazy_glCullFace(GLenum p0)
+{
+    ((PFNGLCULLFACEPROC) gregResolveCommand(26))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glDeleteBuffers(GLsizei p0, const GLuint *p1)
+{
+    ((PFNGLDELETEBUFFERSPROC) gregResolveCommand(27))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glDeleteTextures(GLsizei p0, const GLuint *p1)
+{
+    ((PFNGLDELETETEXTURESPROC) gregResolveCommand(28))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glDepthFunc(GLenum p0)
+{
+    ((PFNGLDEPTHFUNCPROC) gregResolveCommand(29))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glDepthMask(GLboolean p0)
+{
+    ((PFNGLDEPTHMASKPROC) gregResolveCommand(30))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glDepthRangef(GLfloat p0, GLfloat p1)
+{
+    ((PFNGLDEPTHRANGEFPROC) gregResolveCommand(31))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glDepthRangex(GLfixed p0, GLfixed p1)
+{
+    ((PFNGLDEPTHRANGEXPROC) gregResolveCommand(32))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glDisable(GLenum p0)
+{
+    ((PFNGLDISABLEPROC) gregResolveCommand(33))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glDisableClientState(GLenum p0)
+{
+    ((PFNGLDISABLECLIENTSTATEPROC) gregResolveCommand(34))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glDrawArrays(GLenum p0, GLint p1, GLsizei p2)
+{
+    ((PFNGLDRAWARRAYSPROC) gregResolveCommand(35))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glDrawElements(GLenum p0, GLsizei p1, GLenum p2, const void *p3)
+{
+    ((PFNGLDRAWELEMENTSPROC) gregResolveCommand(36))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glEnable(GLenum p0)
+{
+    ((PFNGLENABLEPROC) gregResolveCommand(37))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glEnableClientState(GLenum p0)
+{
+    ((PFNGLENABLECLIENTSTATEPROC) gregResolveCommand(38))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glFinish(void)
+{
+    ((PFNGLFINISHPROC) gregResolveCommand(39))();
+}
+
+static void  GLAPIENTRY gregLazy_glFlush(void)
+{
+    ((PFNGLFLUSHPROC) gregResolveCommand(40))();
+}
+
+static void  GLAPIENTRY gregLazy_glFogf(GLenum p0, GLfloat p1)
+{
+    ((PFNGLFOGFPROC) gregResolveCommand(41))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glFogfv(GLenum p0, const GLfloat *p1)
+{
+    ((PFNGLFOGFVPROC) gregResolveCommand(42))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glFogx(GLenum p0, GLfixed p1)
+{
+    ((PFNGLFOGXPROC) gregResolveCommand(43))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glFogxv(GLenum p0, const GLfixed *p1)
+{
+    ((PFNGLFOGXVPROC) gregResolveCommand(44))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glFrontFace(GLenum p0)
+{
+    ((PFNGLFRONTFACEPROC) gregResolveCommand(45))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glFrustumf(GLfloat p0, GLfloat p1, GLfloat p2, GLfloat p3, GLfloat p4, GLfloat p5)
+{
+    ((PFNGLFRUSTUMFPROC) gregResolveCommand(46))(p0, p1, p2, p3, p4, p5);
+}
+
+static void  GLAPIENTRY gregLazy_glFrustumx(GLfixed p0, GLfixed p1, GLfixed p2, GLfixed p3, GLfixed p4, GLfixed p5)
+{
+    ((PFNGLFRUSTUMXPROC) gregResolveCommand(47))(p0, p1, p2, p3, p4, p5);
+}
+
+static void  GLAPIENTRY gregLazy_glGenBuffers(GLsizei p0, GLuint *p1)
+{
+    ((PFNGLGENBUFFERSPROC) gregResolveCommand(48))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glGenTextures(GLsizei p0, GLuint *p1)
+{
+    ((PFNGLGENTEXTURESPROC) gregResolveCommand(49))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glGetBooleanv(GLenum p0, GLboolean *p1)
+{
+    ((PFNGLGETBOOLEANVPROC) gregResolveCommand(50))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glGetBufferParameteriv(GLenum p0, GLenum p1, GLint *p2)
+{
+    ((PFNGLGETBUFFERPARAMETERIVPROC) gregResolveCommand(51))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glGetClipPlanef(GLenum p0, GLfloat *p1)
+{
+    ((PFNGLGETCLIPPLANEFPROC) gregResolveCommand(52))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glGetClipPlanex(GLenum p0, GLfixed *p1)
+{
+    ((PFNGLGETCLIPPLANEXPROC) gregResolveCommand(53))(p0, p1);
+}
+
+static GLenum GLAPIENTRY gregLazy_glGetError(void)
+{
+    return ((PFNGLGETERRORPROC) gregResolveCommand(54))();
+}
+
+static void  GLAPIENTRY gregLazy_glGetFixedv(GLenum p0, GLfixed *p1)
+{
+    ((PFNGLGETFIXEDVPROC) gregResolveCommand(55))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glGetFloatv(GLenum p0, GLfloat *p1)
+{
+    ((PFNGLGETFLOATVPROC) gregResolveCommand(56))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glGetIntegerv(GLenum p0, GLint *p1)
+{
+    ((PFNGLGETINTEGERVPROC) gregResolveCommand(57))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glGetLightfv(GLenum p0, GLenum p1, GLfloat *p2)
+{
+    ((PFNGLGETLIGHTFVPROC) gregResolveCommand(58))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glGetLightxv(GLenum p0, GLenum p1, GLfixed *p2)
+{
+    ((PFNGLGETLIGHTXVPROC) gregResolveCommand(59))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glGetMaterialfv(GLenum p0, GLenum p1, GLfloat *p2)
+{
+    ((PFNGLGETMATERIALFVPROC) gregResolveCommand(60))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glGetMaterialxv(GLenum p0, GLenum p1, GLfixed *p2)
+{
+    ((PFNGLGETMATERIALXVPROC) gregResolveCommand(61))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glGetPointerv(GLenum p0, void **p1)
+{
+    ((PFNGLGETPOINTERVPROC) gregResolveCommand(62))(p0, p1);
+}
+
+static const GLubyte * GLAPIENTRY gregLazy_glGetString(GLenum p0)
+{
+    return ((PFNGLGETSTRINGPROC) gregResolveCommand(63))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glGetTexEnvfv(GLenum p0, GLenum p1, GLfloat *p2)
+{
+    ((PFNGLGETTEXENVFVPROC) gregResolveCommand(64))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glGetTexEnviv(GLenum p0, GLenum p1, GLint *p2)
+{
+    ((PFNGLGETTEXENVIVPROC) gregResolveCommand(65))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glGetTexEnvxv(GLenum p0, GLenum p1, GLfixed *p2)
+{
+    ((PFNGLGETTEXENVXVPROC) gregResolveCommand(66))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glGetTexParameterfv(GLenum p0, GLenum p1, GLfloat *p2)
+{
+    ((PFNGLGETTEXPARAMETERFVPROC) gregResolveCommand(67))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glGetTexParameteriv(GLenum p0, GLenum p1, GLint *p2)
+{
+    ((PFNGLGETTEXPARAMETERIVPROC) gregResolveCommand(68))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glGetTexParameterxv(GLenum p0, GLenum p1, GLfixed *p2)
+{
+    ((PFNGLGETTEXPARAMETERXVPROC) gregResolveCommand(69))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glHint(GLenum p0, GLenum p1)
+{
+    ((PFNGLHINTPROC) gregResolveCommand(70))(p0, p1);
+}
+
+static GLboolean GLAPIENTRY gregLazy_glIsBuffer(GLuint p0)
+{
+    return ((PFNGLISBUFFERPROC) gregResolveCommand(71))(p0);
+}
+
+static GLboolean GLAPIENTRY gregLazy_glIsEnabled(GLenum p0)
+{
+    return ((PFNGLISENABLEDPROC) gregResolveCommand(72))(p0);
+}
+
+static GLboolean GLAPIENTRY gregLazy_glIsTexture(GLuint p0)
+{
+    return ((PFNGLISTEXTUREPROC) gregResolveCommand(73))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glLightModelf(GLenum p0, GLfloat p1)
+{
+    ((PFNGLLIGHTMODELFPROC) gregResolveCommand(74))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glLightModelfv(GLenum p0, const GLfloat *p1)
+{
+    ((PFNGLLIGHTMODELFVPROC) gregResolveCommand(75))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glLightModelx(GLenum p0, GLfixed p1)
+{
+    ((PFNGLLIGHTMODELXPROC) gregResolveCommand(76))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glLightModelxv(GLenum p0, const GLfixed *p1)
+{
+    ((PFNGLLIGHTMODELXVPROC) gregResolveCommand(77))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glLightf(GLenum p0, GLenum p1, GLfloat p2)
+{
+    ((PFNGLLIGHTFPROC) gregResolveCommand(78))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glLightfv(GLenum p0, GLenum p1, const GLfloat *p2)
+{
+    ((PFNGLLIGHTFVPROC) gregResolveCommand(79))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glLightx(GLenum p0, GLenum p1, GLfixed p2)
+{
+    ((PFNGLLIGHTXPROC) gregResolveCommand(80))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glLightxv(GLenum p0, GLenum p1, const GLfixed *p2)
+{
+    ((PFNGLLIGHTXVPROC) gregResolveCommand(81))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glLineWidth(GLfloat p0)
+{
+    ((PFNGLLINEWIDTHPROC) gregResolveCommand(82))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glLineWidthx(GLfixed p0)
+{
+    ((PFNGLLINEWIDTHXPROC) gregResolveCommand(83))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glLoadIdentity(void)
+{
+    ((PFNGLLOADIDENTITYPROC) gregResolveCommand(84))();
+}
+
+static void  GLAPIENTRY gregLazy_glLoadMatrixf(const GLfloat *p0)
+{
+    ((PFNGLLOADMATRIXFPROC) gregResolveCommand(85))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glLoadMatrixx(const GLfixed *p0)
+{
+    ((PFNGLLOADMATRIXXPROC) gregResolveCommand(86))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glLogicOp(GLenum p0)
+{
+    ((PFNGLLOGICOPPROC) gregResolveCommand(87))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glMaterialf(GLenum p0, GLenum p1, GLfloat p2)
+{
+    ((PFNGLMATERIALFPROC) gregResolveCommand(88))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glMaterialfv(GLenum p0, GLenum p1, const GLfloat *p2)
+{
+    ((PFNGLMATERIALFVPROC) gregResolveCommand(89))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glMaterialx(GLenum p0, GLenum p1, GLfixed p2)
+{
+    ((PFNGLMATERIALXPROC) gregResolveCommand(90))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glMaterialxv(GLenum p0, GLenum p1, const GLfixed *p2)
+{
+    ((PFNGLMATERIALXVPROC) gregResolveCommand(91))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glMatrixMode(GLenum p0)
+{
+    ((PFNGLMATRIXMODEPROC) gregResolveCommand(92))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glMultMatrixf(const GLfloat *p0)
+{
+    ((PFNGLMULTMATRIXFPROC) gregResolveCommand(93))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glMultMatrixx(const GLfixed *p0)
+{
+    ((PFNGLMULTMATRIXXPROC) gregResolveCommand(94))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glMultiTexCoord4f(GLenum p0, GLfloat p1, GLfloat p2, GLfloat p3, GLfloat p4)
+{
+    ((PFNGLMULTITEXCOORD4FPROC) gregResolveCommand(95))(p0, p1, p2, p3, p4);
+}
+
+static void  GLAPIENTRY gregLazy_glMultiTexCoord4x(GLenum p0, GLfixed p1, GLfixed p2, GLfixed p3, GLfixed p4)
+{
+    ((PFNGLMULTITEXCOORD4XPROC) gregResolveCommand(96))(p0, p1, p2, p3, p4);
+}
+
+static void  GLAPIENTRY gregLazy_glNormal3f(GLfloat p0, GLfloat p1, GLfloat p2)
+{
+    ((PFNGLNORMAL3FPROC) gregResolveCommand(97))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glNormal3x(GLfixed p0, GLfixed p1, GLfixed p2)
+{
+    ((PFNGLNORMAL3XPROC) gregResolveCommand(98))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glNormalPointer(GLenum p0, GLsizei p1, const void *p2)
+{
+    ((PFNGLNORMALPOINTERPROC) gregResolveCommand(99))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glOrthof(GLfloat p0, GLfloat p1, GLfloat p2, GLfloat p3, GLfloat p4, GLfloat p5)
+{
+    ((PFNGLORTHOFPROC) gregResolveCommand(100))(p0, p1, p2, p3, p4, p5);
+}
+
+static void  GLAPIENTRY gregLazy_glOrthox(GLfixed p0, GLfixed p1, GLfixed p2, GLfixed p3, GLfixed p4, GLfixed p5)
+{
+    ((PFNGLORTHOXPROC) gregResolveCommand(101))(p0, p1, p2, p3, p4, p5);
+}
+
+static void  GLAPIENTRY gregLazy_glPixelStorei(GLenum p0, GLint p1)
+{
+    ((PFNGLPIXELSTOREIPROC) gregResolveCommand(102))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glPointParameterf(GLenum p0, GLfloat p1)
+{
+    ((PFNGLPOINTPARAMETERFPROC) gregResolveCommand(103))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glPointParameterfv(GLenum p0, const GLfloat *p1)
+{
+    ((PFNGLPOINTPARAMETERFVPROC) gregResolveCommand(104))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glPointParameterx(GLenum p0, GLfixed p1)
+{
+    ((PFNGLPOINTPARAMETERXPROC) gregResolveCommand(105))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glPointParameterxv(GLenum p0, const GLfixed *p1)
+{
+    ((PFNGLPOINTPARAMETERXVPROC) gregResolveCommand(106))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glPointSize(GLfloat p0)
+{
+    ((PFNGLPOINTSIZEPROC) gregResolveCommand(107))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glPointSizex(GLfixed p0)
+{
+    ((PFNGLPOINTSIZEXPROC) gregResolveCommand(108))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glPolygonOffset(GLfloat p0, GLfloat p1)
+{
+    ((PFNGLPOLYGONOFFSETPROC) gregResolveCommand(109))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glPolygonOffsetx(GLfixed p0, GLfixed p1)
+{
+    ((PFNGLPOLYGONOFFSETXPROC) gregResolveCommand(110))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glPopMatrix(void)
+{
+    ((PFNGLPOPMATRIXPROC) gregResolveCommand(111))();
+}
+
+static void  GLAPIENTRY gregLazy_glPushMatrix(void)
+{
+    ((PFNGLPUSHMATRIXPROC) gregResolveCommand(112))();
+}
+
+static void  GLAPIENTRY gregLazy_glReadPixels(GLint p0, GLint p1, GLsizei p2, GLsizei p3, GLenum p4, GLenum p5, void *p6)
+{
+    ((PFNGLREADPIXELSPROC) gregResolveCommand(113))(p0, p1, p2, p3, p4, p5, p6);
+}
+
+static void  GLAPIENTRY gregLazy_glRotatef(GLfloat p0, GLfloat p1, GLfloat p2, GLfloat p3)
+{
+    ((PFNGLROTATEFPROC) gregResolveCommand(114))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glRotatex(GLfixed p0, GLfixed p1, GLfixed p2, GLfixed p3)
+{
+    ((PFNGLROTATEXPROC) gregResolveCommand(115))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glSampleCoverage(GLfloat p0, GLboolean p1)
+{
+    ((PFNGLSAMPLECOVERAGEPROC) gregResolveCommand(116))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glSampleCoveragex(GLclampx p0, GLboolean p1)
+{
+    ((PFNGLSAMPLECOVERAGEXPROC) gregResolveCommand(117))(p0, p1);
+}
+
+static void  GLAPIENTRY gregLazy_glScalef(GLfloat p0, GLfloat p1, GLfloat p2)
+{
+    ((PFNGLSCALEFPROC) gregResolveCommand(118))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glScalex(GLfixed p0, GLfixed p1, GLfixed p2)
+{
+    ((PFNGLSCALEXPROC) gregResolveCommand(119))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glScissor(GLint p0, GLint p1, GLsizei p2, GLsizei p3)
+{
+    ((PFNGLSCISSORPROC) gregResolveCommand(120))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glShadeModel(GLenum p0)
+{
+    ((PFNGLSHADEMODELPROC) gregResolveCommand(121))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glStencilFunc(GLenum p0, GLint p1, GLuint p2)
+{
+    ((PFNGLSTENCILFUNCPROC) gregResolveCommand(122))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glStencilMask(GLuint p0)
+{
+    ((PFNGLSTENCILMASKPROC) gregResolveCommand(123))(p0);
+}
+
+static void  GLAPIENTRY gregLazy_glStencilOp(GLenum p0, GLenum p1, GLenum p2)
+{
+    ((PFNGLSTENCILOPPROC) gregResolveCommand(124))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexCoordPointer(GLint p0, GLenum p1, GLsizei p2, const void *p3)
+{
+    ((PFNGLTEXCOORDPOINTERPROC) gregResolveCommand(125))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glTexEnvf(GLenum p0, GLenum p1, GLfloat p2)
+{
+    ((PFNGLTEXENVFPROC) gregResolveCommand(126))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexEnvfv(GLenum p0, GLenum p1, const GLfloat *p2)
+{
+    ((PFNGLTEXENVFVPROC) gregResolveCommand(127))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexEnvi(GLenum p0, GLenum p1, GLint p2)
+{
+    ((PFNGLTEXENVIPROC) gregResolveCommand(128))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexEnviv(GLenum p0, GLenum p1, const GLint *p2)
+{
+    ((PFNGLTEXENVIVPROC) gregResolveCommand(129))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexEnvx(GLenum p0, GLenum p1, GLfixed p2)
+{
+    ((PFNGLTEXENVXPROC) gregResolveCommand(130))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexEnvxv(GLenum p0, GLenum p1, const GLfixed *p2)
+{
+    ((PFNGLTEXENVXVPROC) gregResolveCommand(131))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexImage2D(GLenum p0, GLint p1, GLint p2, GLsizei p3, GLsizei p4, GLint p5, GLenum p6, GLenum p7, const void *p8)
+{
+    ((PFNGLTEXIMAGE2DPROC) gregResolveCommand(132))(p0, p1, p2, p3, p4, p5, p6, p7, p8);
+}
+
+static void  GLAPIENTRY gregLazy_glTexParameterf(GLenum p0, GLenum p1, GLfloat p2)
+{
+    ((PFNGLTEXPARAMETERFPROC) gregResolveCommand(133))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexParameterfv(GLenum p0, GLenum p1, const GLfloat *p2)
+{
+    ((PFNGLTEXPARAMETERFVPROC) gregResolveCommand(134))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexParameteri(GLenum p0, GLenum p1, GLint p2)
+{
+    ((PFNGLTEXPARAMETERIPROC) gregResolveCommand(135))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexParameteriv(GLenum p0, GLenum p1, const GLint *p2)
+{
+    ((PFNGLTEXPARAMETERIVPROC) gregResolveCommand(136))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexParameterx(GLenum p0, GLenum p1, GLfixed p2)
+{
+    ((PFNGLTEXPARAMETERXPROC) gregResolveCommand(137))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexParameterxv(GLenum p0, GLenum p1, const GLfixed *p2)
+{
+    ((PFNGLTEXPARAMETERXVPROC) gregResolveCommand(138))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTexSubImage2D(GLenum p0, GLint p1, GLint p2, GLint p3, GLsizei p4, GLsizei p5, GLenum p6, GLenum p7, const void *p8)
+{
+    ((PFNGLTEXSUBIMAGE2DPROC) gregResolveCommand(139))(p0, p1, p2, p3, p4, p5, p6, p7, p8);
+}
+
+static void  GLAPIENTRY gregLazy_glTranslatef(GLfloat p0, GLfloat p1, GLfloat p2)
+{
+    ((PFNGLTRANSLATEFPROC) gregResolveCommand(140))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glTranslatex(GLfixed p0, GLfixed p1, GLfixed p2)
+{
+    ((PFNGLTRANSLATEXPROC) gregResolveCommand(141))(p0, p1, p2);
+}
+
+static void  GLAPIENTRY gregLazy_glVertexPointer(GLint p0, GLenum p1, GLsizei p2, const void *p3)
+{
+    ((PFNGLVERTEXPOINTERPROC) gregResolveCommand(142))(p0, p1, p2, p3);
+}
+
+static void  GLAPIENTRY gregLazy_glViewport(GLint p0, GLint p1, GLsizei p2, GLsizei p3)
+{
+    ((PFNGLVIEWPORTPROC) gregResolveCommand(143))(p0, p1, p2, p3);
+}
+
+
+/* OpenGL ES lazy binding trampolines, at the same indices as their commands */
+static const GREGproc greg_trampolines[144] =
+{
+    (GREGproc) gregLazy_glActiveTexture,
+    (GREGproc) gregLazy_glAlphaFunc,
+    (GREGproc) gregLazy_glAlphaFuncx,
+    (GREGproc) gregLazy_glBindBuffer,
+    (GREGproc) gregLazy_glBindTexture,
+    (GREGproc) gregLazy_glBlendFunc,
+    (GREGproc) gregLazy_glBufferData,
+    (GREGproc) gregLazy_glBufferSubData,
+    (GREGproc) gregLazy_glClear,
+    (GREGproc) gregLazy_glClearColor,
+    (GREGproc) gregLazy_glClearColorx,
+    (GREGproc) gregLazy_glClearDepthf,
+    (GREGproc) gregLazy_glClearDepthx,
+    (GREGproc) gregLazy_glClearStencil,
+    (GREGproc) gregLazy_glClientActiveTexture,
+    (GREGproc) gregLazy_glClipPlanef,
+    (GREGproc) gregLazy_glClipPlanex,
+    (GREGproc) gregLazy_glColor4f,
+    (GREGproc) gregLazy_glColor4ub,
+    (GREGproc) gregLazy_glColor4x,
+    (GREGproc) gregLazy_glColorMask,
+    (GREGproc) gregLazy_glColorPointer,
+    (GREGproc) gregLazy_glCompressedTexImage2D,
+    (GREGproc) gregLazy_glCompressedTexSubImage2D,
+    (GREGproc) gregLazy_glCopyTexImage2D,
+    (GREGproc) gregLazy_glCopyTexSubImage2D,
+    (GREGproc) gregLazy_glCullFace,
+    (GREGproc) gregLazy_glDeleteBuffers,
+    (GREGproc) gregLazy_glDeleteTextures,
+    (GREGproc) gregLazy_glDepthFunc,
+    (GREGproc) gregLazy_glDepthMask,
+    (GREGproc) gregLazy_glDepthRangef,
+    (GREGproc) gregLazy_glDepthRangex,
+    (GREGproc) gregLazy_glDisable,
+    (GREGproc) gregLazy_glDisableClientState,
+    (GREGproc) gregLazy_glDrawArrays,
+    (GREGproc) gregLazy_glDrawElements,
+    (GREGproc) gregLazy_glEnable,
+    (GREGproc) gregLazy_glEnableClientState,
+    (GREGproc) gregLazy_glFinish,
+    (GREGproc) gregLazy_glFlush,
+    (GREGproc) gregLazy_glFogf,
+    (GREGproc) gregLazy_glFogfv,
+    (GREGproc) gregLazy_glFogx,
+    (GREGproc) gregLazy_glFogxv,
+    (GREGproc) gregLazy_glFrontFace,
+    (GREGproc) gregLazy_glFrustumf,
+    (GREGproc) gregLazy_glFrustumx,
+    (GREGproc) gregLazy_glGenBuffers,
+    (GREGproc) gregLazy_glGenTextures,
+    (GREGproc) gregLazy_glGetBooleanv,
+    (GREGproc) gregLazy_glGetBufferParameteriv,
+    (GREGproc) gregLazy_glGetClipPlanef,
+    (GREGproc) gregLazy_glGetClipPlanex,
+    (GREGproc) gregLazy_glGetError,
+    (GREGproc) gregLazy_glGetFixedv,
+    (GREGproc) gregLazy_glGetFloatv,
+    (GREGproc) gregLazy_glGetIntegerv,
+    (GREGproc) gregLazy_glGetLightfv,
+    (GREGproc) gregLazy_glGetLightxv,
+    (GREGproc) gregLazy_glGetMaterialfv,
+    (GREGproc) gregLazy_glGetMaterialxv,
+    (GREGproc) gregLazy_glGetPointerv,
+    (GREGproc) gregLazy_glGetString,
+    (GREGproc) gregLazy_glGetTexEnvfv,
+    (GREGproc) gregLazy_glGetTexEnviv,
+    (GREGproc) gregLazy_glGetTexEnvxv,
+    (GREGproc) gregLazy_glGetTexParameterfv,
+    (GREGproc) gregLazy_glGetTexParameteriv,
+    (GREGproc) gregLazy_glGetTexParameterxv,
+    (GREGproc) gregLazy_glHint,
+    (GREGproc) gregLazy_glIsBuffer,
+    (GREGproc) gregLazy_glIsEnabled,
+    (GREGproc) gregLazy_glIsTexture,
+    (GREGproc) gregLazy_glLightModelf,
+    (GREGproc) gregLazy_glLightModelfv,
+    (GREGproc) gregLazy_glLightModelx,
+    (GREGproc) gregLazy_glLightModelxv,
+    (GREGproc) gregLazy_glLightf,
+    (GREGproc) gregLazy_glLightfv,
+    (GREGproc) gregLazy_glLightx,
+    (GREGproc) gregLazy_glLightxv,
+    (GREGproc) gregLazy_glLineWidth,
+    (GREGproc) gregLazy_glLineWidthx,
+    (GREGproc) gregLazy_glLoadIdentity,
+    (GREGproc) gregLazy_glLoadMatrixf,
+    (GREGproc) gregLazy_glLoadMatrixx,
+    (GREGproc) gregLazy_glLogicOp,
+    (GREGproc) gregLazy_glMaterialf,
+    (GREGproc) gregLazy_glMaterialfv,
+    (GREGproc) gregLazy_glMaterialx,
+    (GREGproc) gregLazy_glMaterialxv,
+    (GREGproc) gregLazy_glMatrixMode,
+    (GREGproc) gregLazy_glMultMatrixf,
+    (GREGproc) gregLazy_glMultMatrixx,
+    (GREGproc) gregLazy_glMultiTexCoord4f,
+    (GREGproc) gregLazy_glMultiTexCoord4x,
+    (GREGproc) gregLazy_glNormal3f,
+    (GREGproc) gregLazy_glNormal3x,
+    (GREGproc) gregLazy_glNormalPointer,
+    (GREGproc) gregLazy_glOrthof,
+    (GREGproc) gregLazy_glOrthox,
+    (GREGproc) gregLazy_glPixelStorei,
+    (GREGproc) gregLazy_glPointParameterf,
+    (GREGproc) gregLazy_glPointParameterfv,
+    (GREGproc) gregLazy_glPointParameterx,
+    (GREGproc) gregLazy_glPointParameterxv,
+    (GREGproc) gregLazy_glPointSize,
+    (GREGproc) gregLazy_glPointSizex,
+    (GREGproc) gregLazy_glPolygonOffset,
+    (GREGproc) gregLazy_glPolygonOffsetx,
+    (GREGproc) gregLazy_glPopMatrix,
+    (GREGproc) gregLazy_glPushMatrix,
+    (GREGproc) gregLazy_glReadPixels,
+    (GREGproc) gregLazy_glRotatef,
+    (GREGproc) gregLazy_glRotatex,
+    (GREGproc) gregLazy_glSampleCoverage,
+    (GREGproc) gregLazy_glSampleCoveragex,
+    (GREGproc) gregLazy_glScalef,
+    (GREGproc) gregLazy_glScalex,
+    (GREGproc) gregLazy_glScissor,
+    (GREGproc) gregLazy_glShadeModel,
+    (GREGproc) gregLazy_glStencilFunc,
+    (GREGproc) gregLazy_glStencilMask,
+    (GREGproc) gregLazy_glStencilOp,
+    (GREGproc) gregLazy_glTexCoordPointer,
+    (GREGproc) gregLazy_glTexEnvf,
+    (GREGproc) gregLazy_glTexEnvfv,
+    (GREGproc) gregLazy_glTexEnvi,
+    (GREGproc) gregLazy_glTexEnviv,
+    (GREGproc) gregLazy_glTexEnvx,
+    (GREGproc) gregLazy_glTexEnvxv,
+    (GREGproc) gregLazy_glTexImage2D,
+    (GREGproc) gregLazy_glTexParameterf,
+    (GREGproc) gregLazy_glTexParameterfv,
+    (GREGproc) gregLazy_glTexParameteri,
+    (GREGproc) gregLazy_glTexParameteriv,
+    (GREGproc) gregLazy_glTexParameterx,
+    (GREGproc) gregLazy_glTexParameterxv,
+    (GREGproc) gregLazy_glTexSubImage2D,
+    (GREGproc) gregLazy_glTranslatef,
+    (GREGproc) gregLazy_glTranslatex,
+    (GREGproc) gregLazy_glVertexPointer,
+    (GREGproc) gregLazy_glViewport,
+};
+
+#endif
+
+/* OpenGL ES versions and extensions, with the end of their commands in load order */
+#define GREG_FEATURE_COUNT 1
+
+static const unsigned short greg_group_ends[] =
+{
+    144,
+};
+
+#define GREG_SLOT(position) (position)
+
+#define GREG_ALIAS_COUNT 0
+
+/* Loads the specified range of the function pointer table in load order
+ * With lazy binding the table is pointed at the trampolines instead
+ */
+static void gregLoadCommands(size_t first, size_t end)
+{
+    size_t i;
+
+    for (i = first;  i < end;  i++)
+    {
+#if defined(GREG_LAZY)
+        GREG_PROCS[GREG_SLOT(i)] = greg_trampolines[GREG_SLOT(i)];
+#else
+        GREG_PROCS[GREG_SLOT(i)] = gregGetCommandAddress(GREG_SLOT(i));
+#endif
+    }
+}
+
+/* Loads the commands of the specified range of versions and extensions
+ * The commands of unsupported versions and extensions are set to NULL
+ */
+static void gregLoadGroups(size_t first, size_t end)
+{
+    size_t i, j;
+
+    for (i = first;  i < end;  i++)
+    {
+        const size_t start = i ? greg_group_ends[i - 1] : 0;
+
+        if (GREG_BOOLEANS[i])
+            gregLoadCommands(start, greg_group_ends[i]);
+        else
+        {
+            for (j = start;  j < greg_group_ends[i];  j++)
+                GREG_PROCS[GREG_SLOT(j)] = NULL;
+        }
+    }
+}
+
+#if GREG_ALIAS_COUNT > 0
+/* Loads the entries with several owners, as aliases or as commands of several
+ * versions and extensions, which follow those of all versions and extensions
+ * in load order, if any of the owners of the entry are supported
+ */
+static void gregLoadAliases(void)
+{
+    size_t i, j;
+
+    for (i = 0;  i < GREG_ALIAS_COUNT;  i++)
+    {
+        const size_t position = 144 - GREG_ALIAS_COUNT + i;
+        const size_t start = i ? greg_alias_owner_ends[i - 1] : 0;
+
+        for (j = start;  j < greg_alias_owner_ends[i];  j++)
+        {
+            if (GREG_BOOLEANS[greg_alias_owners[j]])
+                break;
+        }
+
+        if (j < greg_alias_owner_ends[i])
+            gregLoadCommands(position, position + 1);
+        else
+            GREG_PROCS[GREG_SLOT(position)] = NULL;
+    }
+}
+#endif
+
+/* Checks whether the specified OpenGL ES version is supported
+ */
+static int gregVersionSupported(int major, int minor)
+{
+    return _greg_version.major > major ||
+           (_greg_version.major == major && _greg_version.minor >= minor);
+}
+
+/* Checks which OpenGL ES versions are supported
+ * The version must already be known
+ */
+static void gregDetectVersions(void)
+{
+    /* Check supported OpenGL ES versions */
+    GREG_VERSION_ES_CM_1_0 = gregVersionSupported(1, 0);
+
+}
+
+/* Loads the functions of the supported versions, except those of the lowest
+ * version
+ * This must come before checking extensions, as the query of later versions
+ * may be among them
+ */
+static void gregLoadVersions(void)
+{
+    /* Load functions of supported OpenGL ES versions */
+    gregLoadGroups(1, GREG_FEATURE_COUNT);
+}
+
+#if GREG_EXTENSION_COUNT > 0
+/* Returns the FNV-1a hash of the specified string of the specified length,
+ * starting from the specified basis, followed by the MurmurHash3 finalizer
+ */
+static unsigned long gregHashString(const char* string, size_t length, unsigned long hash)
+{
+    while (length--)
+    {
+        hash ^= (unsigned char) *string++;
+        hash = (hash * 16777619ul) & 0xfffffffful;
+    }
+
+    hash ^= hash >> 16;
+    hash = (hash * 0x85ebca6bul) & 0xfffffffful;
+    hash ^= hash >> 13;
+    hash = (hash * 0xc2b2ae35ul) & 0xfffffffful;
+    hash ^= hash >> 16;
+
+    return hash;
+}
+
+/* Marks the specified OpenGL ES extension as supported if it was requested
+ * The requested extensions are stored in the slots of a perfect hash
+ * The name does not need to be terminated, so it can point into a string
+ */
+static void gregMarkExtension(const char* name, size_t length)
+{
+    const unsigned long bucket = gregHashString(name, length, 2166136261ul) % GREG_EXTENSION_COUNT;
+    const unsigned long slot = gregHashString(name, length, greg_extension_seeds[bucket]) % GREG_EXTENSION_COUNT;
+    const char* requested = greg_extension_names + greg_extension_offsets[slot];
+
+    if (strncmp(requested, name, length) == 0 && requested[length] == '\0')
+        GREG_BOOLEANS[greg_extension_booleans[slot]] = 1;
+}
+
+/* Marks the requested OpenGL ES extensions in the specified space-separated
+ * list as supported, in a single pass over the list
+ */
+static void gregMarkExtensions(const char* e)
+{
+    if (!e)
+        return;
+
+    while (*e)
+    {
+        const char* start;
+
+        while (*e == ' ')
+            e++;
+
+        start = e;
+
+        while (*e && *e != ' ')
+            e++;
+
+        if (e > start)
+            gregMarkExtension(start, e - start);
+    }
+}
+#endif /* GREG_EXTENSION_COUNT */
+
+/* Loads the functions of the supported extensions and the shared functions
+ */
+static void gregLoadExtensions(void)
+{
+#if GREG_EXTENSION_COUNT > 0
+    /* Load functions of supported OpenGL ES extensions */
+    gregLoadGroups(GREG_FEATURE_COUNT, GREG_FEATURE_COUNT + GREG_EXTENSION_COUNT);
+#endif
+
+#if GREG_ALIAS_COUNT > 0
+    /* Load functions shared by supported versions and extensions */
+    gregLoadAliases();
+#endif
+}
+
+/* Parses version numbers from the OpenGL ES version string
+ */
+static GLboolean gregParseVersionString(void)
+{
+    int i;
+    const char* version;
+    const PFNGLGETSTRINGPROC getString = glGetString;
+    const char* prefixes[] =
+    {
+        "OpenGL ES-CM ",
+        "OpenGL ES-CL ",
+        "OpenGL ES ",
+        NULL
+    };
+
+    /* The functions are checked through pointers as they may be linked directly */
+    if (!getString)
+        return GL_FALSE;
+
+    version = (const char*) getString(GL_VERSION);
+    if (!version)
+        return GL_FALSE;
+
+    for (i = 0;  prefixes[i];  i++)
+    {
+        const size_t length = strlen(prefixes[i]);
+        if (strncmp(version, prefixes[i], length) == 0)
+        {
+            version += length;
+            break;
+        }
+    }
+
+#if defined(_MSC_VER)
+    if (!sscanf_s(version, "%d.%d", &_greg_version.major, &_greg_version.minor))
+        return GL_FALSE;
+#else
+    if (!sscanf(version, "%d.%d", &_greg_version.major, &_greg_version.minor))
+        return GL_FALSE;
+#endif
+
+    return GL_TRUE;
+}
+
+/* Queries the version of the current OpenGL ES context
+ * The integers of GL_MAJOR_VERSION and GL_MINOR_VERSION are used when the
+ * previous context had them, as older contexts report an error for them,
+ * and the version string is parsed otherwise
+ */
+static GLboolean gregQueryVersion(void)
+{
+#if defined(GL_MAJOR_VERSION) && defined(GL_MINOR_VERSION)
+    const PFNGLGETINTEGERVPROC getIntegerv = glGetIntegerv;
+
+    if (_greg_version.major >= 3 && getIntegerv)
+    {
+        GLint major = 0, minor = 0;
+
+        getIntegerv(GL_MAJOR_VERSION, &major);
+        getIntegerv(GL_MINOR_VERSION, &minor);
+
+        if (major >= 3)
+        {
+            _greg_version.major = major;
+            _greg_version.minor = minor;
+            return GL_TRUE;
+        }
+    }
+#endif
+
+    return gregParseVersionString();
+}
+
+#if GREG_EXTENSION_COUNT > 0
+/* Checks which of the requested OpenGL ES extensions are supported
+ * The extensions of the context are retrieved and looked up only once, so
+ * this takes time linear in the length of the extension list
+ */
+static void gregDetectExtensions(void)
+{
+    const char* e;
+    const PFNGLGETSTRINGPROC getString = glGetString;
+
+#if defined(GL_VERSION_3_0) || defined(GL_ES_VERSION_3_0)
+    if (_greg_version.major >= 3)
+    {
+        const PFNGLGETINTEGERVPROC getIntegerv = glGetIntegerv;
+        const PFNGLGETSTRINGIPROC getStringi = glGetStringi;
+        GLint i, count;
+
+        if (!getIntegerv || !getStringi)
+            return;
+
+        getIntegerv(GL_NUM_EXTENSIONS, &count);
+
+        for (i = 0;  i < count;  i++)
+        {
+            e = (const char*) getStringi(GL_EXTENSIONS, i);
+            if (!e)
+                return;
+
+            gregMarkExtension(e, strlen(e));
+        }
+
+        return;
+    }
+#endif
+
+    if (!getString)
+        return;
+
+    gregMarkExtensions((const char*) getString(GL_EXTENSIONS));
+}
+#endif /* GREG_EXTENSION_COUNT */
+
+/* Packs the version and extension booleans into the set of capabilities
+ */
+static void gregPackCapabilities(void)
+{
+    size_t i;
+
+    memset(&GREG_CAPABILITIES, 0, sizeof(GregCapabilities));
+
+    for (i = 0;  i < 1;  i++)
+    {
+        if (GREG_BOOLEANS[i])
+            GREG_CAPABILITIES.bits[i / 32] |= 1ul << (i % 32);
+    }
+}
+
+/* Checks versions and extensions and loads functions for the current context
+ */
+static int gregLoadContext(void)
+{
+    if (!gregHasContext() || !gregLoadLibrary())
+        return GL_FALSE;
+
+    /* Load the functions of the lowest OpenGL ES version, which include
+     * those used to check versions and extensions */
+    gregLoadCommands(0, greg_group_ends[0]);
+
+    if (!gregParseVersionString())
+        return GL_FALSE;
+
+    gregDetectVersions();
+    gregLoadVersions();
+
+#if GREG_EXTENSION_COUNT > 0
+    /* Check supported OpenGL ES extensions */
+    gregDetectExtensions();
+#endif
+
+    gregPackCapabilities();
+    gregLoadExtensions();
+    return GL_TRUE;
+}
+
+#if defined(GREG_MULTI_CONTEXT)
+GREGDEF int gregInitContext(GregContext* context)
+{
+    memset(context, 0, sizeof(GregContext));
+
+    greg_context = context;
+    return gregLoadContext();
+}
+
+GREGDEF void gregMakeCurrent(GregContext* context)
+{
+    greg_context = context;
+}
+#else
+GREGDEF int gregInit(void)
+{
+    memset(greg_booleans, 0, sizeof(greg_booleans));
+
+    return gregLoadContext();
+}
+#endif
+
+GREGDEF int gregReinit(int* changed)
+{
+    int previous[1];
+    GLboolean different;
+
+#if defined(GREG_MULTI_CONTEXT)
+    if (!greg_context)
+        return GL_FALSE;
+#endif
+
+    if (!_greg.loaded)
+    {
+        if (changed)
+            *changed = GL_TRUE;
+
+        memset(GREG_BOOLEANS, 0, sizeof(previous));
+        return gregLoadContext();
+    }
+
+    if (!gregHasContext())
+        return GL_FALSE;
+
+    memcpy(previous, GREG_BOOLEANS, sizeof(previous));
+    memset(GREG_BOOLEANS, 0, sizeof(previous));
+
+#if defined(_GREG_CONTEXT_PROCS)
+    gregLoadCommands(0, greg_group_ends[0]);
+#endif
+
+    if (!gregQueryVersion())
+        return GL_FALSE;
+
+    gregDetectVersions();
+
+    /* Pointers that don't depend on the context only need to be loaded
+     * again if the set of supported versions and extensions changed */
+#if !defined(_GREG_CONTEXT_PROCS)
+    if (memcmp(previous, GREG_BOOLEANS, GREG_FEATURE_COUNT * sizeof(int)) != 0)
+#endif
+    {
+        gregLoadVersions();
+    }
+
+#if GREG_EXTENSION_COUNT > 0
+    gregDetectExtensions();
+#endif
+
+    gregPackCapabilities();
+
+    different = memcmp(previous, GREG_BOOLEANS, sizeof(previous)) != 0;
+    if (changed)
+        *changed = different;
+
+#if !defined(_GREG_CONTEXT_PROCS)
+    if (different)
+#endif
+    {
+        gregLoadExtensions();
+    }
+
+    return GL_TRUE;
+}
+
+GREGDEF void gregTerminate(void)
+{
+    gregFreeLibrary();
+}
+
+#endif /*GREG_IMPLEMENTATION*/
@@ -0,0 +1,198 @@
+/* Measures what a generated loader costs on a headless EGL context
+ *
+ * Each build of this program includes one configuration of the generated
+ * loader, named by GREG_BENCH_CONFIG, and appends a single line of JSON with
+ * its results to the file given as the first argument
+ */
+
+#if !defined(_WIN32)
+ #define _POSIX_C_SOURCE 199309L
+#endif
+
+#define GREG_IMPLEMENTATION
+#include "greg.h"
+
+#include <EGL/egl.h>
+#include <stdio.h>
+
+#if defined(_WIN32)
+ #include <windows.h>
+#else
+ #include <time.h>
+#endif
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+ #define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+#define BENCH_STRING(x) #x
+#define BENCH_NAME(x) BENCH_STRING(x)
+
+/* The number of repetitions of each initialization and call */
+#define BENCH_INITS 100
+#define BENCH_CALLS 1000000
+
+typedef EGLDisplay (EGLAPIENTRY * PFNBENCHGETPLATFORMDISPLAYPROC)(EGLenum, void*, const EGLint*);
+
+/* Returns the time in seconds since some fixed point
+ */
+static double benchGetTime(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double) counter.QuadPart / (double) frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+#endif
+}
+
+/* Makes a headless OpenGL context current, preferring a surfaceless display
+ * and falling back to a small pbuffer on the default display
+ */
+static int benchCreateContext(void)
+{
+    const EGLint surfaceless[] = { EGL_SURFACE_TYPE, 0, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    const EGLint pbuffer[] = { EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    const EGLint size[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+    const PFNBENCHGETPLATFORMDISPLAYPROC getPlatformDisplay =
+        (PFNBENCHGETPLATFORMDISPLAYPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLSurface surface = EGL_NO_SURFACE;
+    EGLConfig config;
+    EGLContext context;
+    EGLint count;
+
+    if (getPlatformDisplay)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL))
+    {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (!eglInitialize(display, NULL, NULL))
+            return 0;
+
+        if (!eglChooseConfig(display, pbuffer, &config, 1, &count) || !count)
+            return 0;
+
+        surface = eglCreatePbufferSurface(display, config, size);
+        if (surface == EGL_NO_SURFACE)
+            return 0;
+    }
+    else if (!eglChooseConfig(display, surfaceless, &config, 1, &count) || !count)
+        return 0;
+
+    if (!eglBindAPI(EGL_OPENGL_API))
+        return 0;
+
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, NULL);
+    if (context == EGL_NO_CONTEXT)
+        return 0;
+
+    return eglMakeCurrent(display, surface, surface, context);
+}
+
+#if defined(GREG_MULTI_CONTEXT)
+static GregContext benchContext;
+
+ #define benchInit() gregInitContext(&benchContext)
+#else
+ #define benchInit() gregInit()
+#endif
+
+/* Writes the nanoseconds per call through the loader and through the
+ * pointer returned by the platform for the specified function
+ * Both are warmed up before timing, the raw pointer by an untimed loop and
+ * the loader by a single call, which also resolves lazily bound functions
+ */
+#define BENCH_DISPATCH(output, type, name, call) \
+    { \
+        const type raw = (type) gregGetProcAddress(#name); \
+        double start, loader, direct; \
+        long i; \
+        for (i = 0;  i < BENCH_CALLS;  i++) \
+            raw call; \
+        name call; \
+        start = benchGetTime(); \
+        for (i = 0;  i < BENCH_CALLS;  i++) \
+            raw call; \
+        direct = (benchGetTime() - start) * 1e9 / BENCH_CALLS; \
+        start = benchGetTime(); \
+        for (i = 0;  i < BENCH_CALLS;  i++) \
+            name call; \
+        loader = (benchGetTime() - start) * 1e9 / BENCH_CALLS; \
+        fprintf(output, "%s\"%s\": {\"loader_ns\": %.3f, \"raw_ns\": %.3f}", \
+                first ? "" : ", ", #name, loader, direct); \
+        first = 0; \
+    }
+
+int main(int argc, char** argv)
+{
+    FILE* output = stdout;
+    double start, first_init, init, reinit, extensions = 0.0;
+    int i, changed, first = 1;
+
+    if (!benchCreateContext())
+    {
+        fprintf(stderr, "Failed to create a headless context\n");
+        return 1;
+    }
+
+    if (argc > 1)
+    {
+        output = fopen(argv[1], "a");
+        if (!output)
+        {
+            fprintf(stderr, "Failed to open %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    start = benchGetTime();
+    if (!benchInit())
+    {
+        fprintf(stderr, "Failed to initialize the loader\n");
+        return 1;
+    }
+    first_init = benchGetTime() - start;
+
+    start = benchGetTime();
+    for (i = 0;  i < BENCH_INITS;  i++)
+        benchInit();
+    init = (benchGetTime() - start) / BENCH_INITS;
+
+    start = benchGetTime();
+    for (i = 0;  i < BENCH_INITS;  i++)
+        gregReinit(&changed);
+    reinit = (benchGetTime() - start) / BENCH_INITS;
+
+#if GREG_EXTENSION_COUNT > 0
+    start = benchGetTime();
+    for (i = 0;  i < BENCH_INITS;  i++)
+        gregDetectExtensions();
+    extensions = (benchGetTime() - start) / BENCH_INITS;
+#endif
+
+    fprintf(output, "{\"config\": \"%s\", \"version\": \"%d.%d\", "
+                    "\"first_init_us\": %.3f, \"init_us\": %.3f, \"reinit_us\": %.3f, "
+                    "\"extensions_us\": %.3f, \"calls\": {",
+            BENCH_NAME(GREG_BENCH_CONFIG), _greg_version.major, _greg_version.minor,
+            first_init * 1e6, init * 1e6, reinit * 1e6, extensions * 1e6);
+
+    BENCH_DISPATCH(output, PFNGLGETERRORPROC, glGetError, ());
+    BENCH_DISPATCH(output, PFNGLISENABLEDPROC, glIsEnabled, (GL_BLEND));
+    BENCH_DISPATCH(output, PFNGLBINDBUFFERPROC, glBindBuffer, (GL_ARRAY_BUFFER, 0));
+    BENCH_DISPATCH(output, PFNGLVERTEXATTRIB4FPROC, glVertexAttrib4f, (1, 0.f, 0.f, 0.f, 1.f));
+    BENCH_DISPATCH(output, PFNGLUNIFORM1FPROC, glUniform1f, (-1, 0.f));
+
+    fprintf(output, "}}\n");
+
+    if (output != stdout)
+        fclose(output);
+
+    gregTerminate();
+    return 0;
+}
@@ -24,16 +24,41 @@
 #include <sstream>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <deque>
 #include <set>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <new>
 
 #include <cstring>
+#include <cctype>
 #include <cstdio>
 #include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+#include <cerrno>
 
 #include <wire.hpp>
 #include <pugixml.hpp>
 #include <getopt.h>
 
+#if defined(_WIN32)
+ #define WIN32_LEAN_AND_MEAN
+ #define NOMINMAX
+ #include <windows.h>
+ #include <direct.h>
+#else
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <dirent.h>
+#endif
+
 // WTF, GCC?!
 #undef major
 #undef minor
@@ -41,6 +66,99 @@
 namespace
 {
 
+// Heap usage, tracked for --stats by the allocation functions below
+// Each block is prefixed with its size so that it can be untracked on free
+// Tracking is only enabled along with stats, before any worker threads start,
+// and blocks allocated without it are prefixed with zero
+//
+bool heap_tracking = false;
+std::atomic<size_t> heap_size(0);
+std::atomic<size_t> heap_peak(0);
+
+const size_t heap_header = sizeof(std::max_align_t);
+
+void* tracked_allocate(size_t size)
+{
+  char* block = (char*) std::malloc(size + heap_header);
+  if (!block)
+    return NULL;
+
+  if (!heap_tracking)
+  {
+    *(size_t*) block = 0;
+    return block + heap_header;
+  }
+
+  *(size_t*) block = size;
+
+  const size_t current = heap_size += size;
+  size_t peak = heap_peak;
+  while (current > peak && !heap_peak.compare_exchange_weak(peak, current))
+    ;
+
+  return block + heap_header;
+}
+
+void tracked_deallocate(void* pointer)
+{
+  if (!pointer)
+    return;
+
+  char* block = (char*) pointer - heap_header;
+  if (const size_t size = *(size_t*) block)
+    heap_size -= size;
+
+  std::free(block);
+}
+
+} /* namespace */
+
+void* operator new(std::size_t size)
+{
+  if (void* pointer = tracked_allocate(size))
+    return pointer;
+
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return tracked_allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return tracked_allocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+  tracked_deallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+  tracked_deallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept
+{
+  tracked_deallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept
+{
+  tracked_deallocate(pointer);
+}
+
+namespace
+{
+
 class Version
 {
 public:
@@ -58,12 +176,176 @@ public:
   unsigned int minor;
 };
 
+// The dense integer ID of a name in a symbol table
+//
+typedef uint32_t Symbol;
+
+const Symbol no_symbol = ~0u;
+
+// Dense integer IDs for the names of one kind of registry item
+// IDs are assigned in the order names are first seen
+//
+struct SymbolTable
+{
+  Symbol intern(const char* name)
+  {
+    const auto result = ids.insert(std::make_pair(std::string(name), (Symbol) names.size()));
+    if (result.second)
+      names.push_back(name);
+
+    return result.first->second;
+  }
+  Symbol find(const char* name) const
+  {
+    const auto entry = ids.find(name);
+    if (entry == ids.end())
+      return no_symbol;
+
+    return entry->second;
+  }
+  size_t size() const { return names.size(); }
+  std::vector<const char*> names;
+  std::unordered_map<std::string, Symbol> ids;
+};
+
+// A set of symbols from one symbol table, stored as one bit per symbol
+// so that sets can be intersected a word at a time
+//
+class Bitset
+{
+public:
+  Bitset() { }
+  explicit Bitset(size_t size): words((size + 63) / 64, 0) { }
+  void set(Symbol symbol) { words[symbol / 64] |= bit(symbol); }
+  void reset(Symbol symbol) { words[symbol / 64] &= ~bit(symbol); }
+  bool test(Symbol symbol) const
+  {
+    return (words[symbol / 64] & bit(symbol)) != 0;
+  }
+  size_t count() const
+  {
+    size_t result = 0;
+
+    for (uint64_t word : words)
+    {
+      for (;  word;  word &= word - 1)
+        result++;
+    }
+
+    return result;
+  }
+  Bitset& operator &= (const Bitset& other)
+  {
+    for (size_t i = 0;  i < words.size();  i++)
+      words[i] &= other.words[i];
+
+    return *this;
+  }
+private:
+  static uint64_t bit(Symbol symbol) { return (uint64_t) 1 << (symbol % 64); }
+  std::vector<uint64_t> words;
+};
+
+// A <require> or <remove> element of a <feature> or <extension>
+//
+struct InterfaceSpec
+{
+  const char* profile;
+  std::vector<Symbol> types;
+  std::vector<Symbol> enums;
+  std::vector<Symbol> commands;
+};
+
+// A <feature> element of the registry
+//
+struct FeatureSpec
+{
+  const char* api;
+  const char* name;
+  Version version;
+  std::vector<InterfaceSpec> required;
+  std::vector<InterfaceSpec> removed;
+};
+
+// An <extension> element of the registry
+//
+struct ExtensionSpec
+{
+  const char* name;
+  const char* supported;
+  std::vector<InterfaceSpec> required;
+  std::vector<InterfaceSpec> removed;
+};
+
+// A <type> element of the registry
+// There may be several elements for the same type name, for different APIs
+//
+struct TypeSpec
+{
+  const char* name;
+  const char* api;
+  const char* text;
+  Symbol symbol;
+  Symbol dependency;
+};
+
+// An <enum> element of the registry
+//
+struct EnumSpec
+{
+  const char* name;
+  const char* value;
+  Symbol symbol;
+};
+
+// A <command> element of the registry
+//
+struct CommandSpec
+{
+  const char* name;
+  const char* proto;
+  const char* params;
+  const char* named_params;
+  uint32_t param_count;
+  Symbol symbol;
+  Symbol alias;
+  std::vector<Symbol> param_types;
+};
+
+// The parts of the registry relevant to loader generation, in document order
+// All strings point either into the source document or into the text pool,
+// so the registry must not outlive the document it was loaded from
+//
+struct Registry
+{
+  std::vector<FeatureSpec> features;
+  std::vector<ExtensionSpec> extensions;
+  std::vector<TypeSpec> types;
+  std::vector<EnumSpec> enums;
+  std::vector<CommandSpec> commands;
+  SymbolTable type_symbols;
+  SymbolTable enum_symbols;
+  SymbolTable command_symbols;
+  std::deque<wire::string> text;
+};
+
 struct Target
 {
   wire::string api;
   wire::string profile;
   Version version;
+  Version direct_version;
   std::set<wire::string> extensions;
+  wire::string template_path;
+  wire::string output_path;
+  wire::string spec_path;
+  wire::string usage_path;
+  wire::string scan_path;
+  bool split;
+  bool types_header;
+  bool modular;
+  bool profiling;
+  bool tracing;
 };
 
 struct Feature
@@ -72,43 +354,332 @@ struct Feature
   Version version;
 };
 
+// The index of a feature or extension that requires an item
+// Features are numbered first, followed by extensions, in manifest order
+//
+typedef uint32_t Owner;
+const Owner no_owner = ~0u;
+
+// The features and extensions that require an item, in manifest order, so
+// the first is the one that introduced it
+//
+typedef std::vector<Owner> Owners;
+
 struct Manifest
 {
   std::vector<Feature> features;
   std::vector<wire::string> extensions;
-  std::set<wire::string> types;
-  std::set<wire::string> commands;
-  std::set<wire::string> enums;
+  Bitset types;
+  Bitset api_types;
+  Bitset commands;
+  Bitset enums;
+  std::vector<Owners> command_owners;
+  std::vector<Owners> enum_owners;
+};
+
+// A memory mapping of an entire file
+// A writable mapping is copy-on-write and never modifies the file itself
+//
+class MappedFile
+{
+public:
+  MappedFile(): data(NULL), size(0) { }
+  ~MappedFile() { close(); }
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator = (const MappedFile&) = delete;
+  bool open(const char* path, bool writable = false)
+  {
+    close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || !file_size.QuadPart)
+    {
+      CloseHandle(file);
+      return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL,
+                                        writable ? PAGE_WRITECOPY : PAGE_READONLY,
+                                        0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping)
+      return false;
+
+    void* view = MapViewOfFile(mapping, writable ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view)
+      return false;
+
+    size = (size_t) file_size.QuadPart;
+#else
+    // Use stdio for the descriptor, as unistd.h clashes with our getopt.h
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file)
+      return false;
+
+    struct stat info;
+    if (fstat(fileno(file), &info) != 0 || !info.st_size)
+    {
+      std::fclose(file);
+      return false;
+    }
+
+    const int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* view = mmap(NULL, info.st_size, protection, MAP_PRIVATE, fileno(file), 0);
+    std::fclose(file);
+    if (view == MAP_FAILED)
+      return false;
+
+    size = info.st_size;
+#endif
+
+    data = (char*) view;
+    return true;
+  }
+  void close()
+  {
+    if (!data)
+      return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+
+    data = NULL;
+    size = 0;
+  }
+  char* data;
+  size_t size;
+};
+
+// A name to be written in uppercase
+//
+struct Uppercase
+{
+  const char* text;
+};
+
+// The prefixes of the identifiers in a generated loader
+// OpenGL and OpenGL ES loaders use plain greg and GREG, and the loaders of
+// the window system APIs add the API, so they can be used alongside
+//
+struct Naming
+{
+  const char* lower;
+  const char* upper;
+  const char* registry;
+};
+
+// The name of the GREG boolean for a feature or extension
+// Names with the prefix of the registry, like GL_, have it replaced with
+// the uppercase prefix of the loader, like GREG_
+//
+struct BooleanName
+{
+  const Naming& naming;
+  const char* name;
+};
+
+// An append-only text buffer for generated output
+// Each piece is written straight into the buffer, without building any
+// temporary strings
+//
+class Buffer
+{
+public:
+  void reserve(size_t size) { text.reserve(size); }
+  size_t size() const { return text.size(); }
+  bool empty() const { return text.empty(); }
+  const std::string& str() const { return text; }
+  Buffer& operator << (const char* piece)
+  {
+    text.append(piece);
+    return *this;
+  }
+  Buffer& operator << (const std::string& piece)
+  {
+    text.append(piece);
+    return *this;
+  }
+  Buffer& operator << (char piece)
+  {
+    text.push_back(piece);
+    return *this;
+  }
+  Buffer& operator << (unsigned int value)
+  {
+    char digits[16];
+    char* start = digits + sizeof(digits);
+    do
+    {
+      *--start = '0' + value % 10;
+      value /= 10;
+    }
+    while (value);
+    text.append(start, digits + sizeof(digits));
+    return *this;
+  }
+  Buffer& operator << (Uppercase piece)
+  {
+    for (const char* c = piece.text;  *c;  c++)
+      text.push_back(std::toupper(*c));
+    return *this;
+  }
+  Buffer& operator << (BooleanName piece)
+  {
+    const size_t length = std::strlen(piece.naming.registry);
+    if (std::strncmp(piece.name, piece.naming.registry, length) == 0)
+      return *this << piece.naming.upper << '_' << piece.name + length;
+    else
+      return *this << piece.name;
+  }
+private:
+  std::string text;
+};
+
+// Output strings for the sub-header of a single feature or extension
+//
+struct ModuleOutput
+{
+  Buffer name;
+  Buffer macro;
+  Buffer declaration;
+  Buffer enum_definitions;
+  Buffer cmd_typedefs;
+  Buffer cmd_macros;
 };
 
 struct Output
 {
-  wire::string api_name;
-  wire::string type_typedefs;
-  wire::string enum_definitions;
-  wire::string ext_macros;
-  wire::string ver_macros;
-  wire::string ext_declarations;
-  wire::string ver_declarations;
-  wire::string ext_definitions;
-  wire::string ver_definitions;
-  wire::string ver_loaders;
-  wire::string ext_loaders;
-  wire::string cmd_typedefs;
-  wire::string cmd_declarations;
-  wire::string cmd_macros;
-  wire::string cmd_definitions;
-  wire::string cmd_loaders;
+  size_t type_count = 0;
+  size_t enum_count = 0;
+  size_t command_count = 0;
+  Buffer split;
+  Buffer header_name;
+  Buffer types_header;
+  Buffer api_name;
+  Buffer group_count;
+  Buffer table_size;
+  Buffer type_typedefs;
+  Buffer enum_definitions;
+  Buffer ext_macros;
+  Buffer ver_macros;
+  Buffer ext_declarations;
+  Buffer ver_declarations;
+  Buffer ver_loaders;
+  Buffer ext_names;
+  Buffer cmd_typedefs;
+  Buffer cmd_macros;
+  Buffer cmd_names;
+  Buffer cmd_trampolines;
+  Buffer cmd_trampoline_table;
+  Buffer cmd_groups;
+  Buffer cmd_profilers;
+  Buffer cmd_tracers;
+  Buffer trace_max_args;
+  Buffer profiling;
+  Buffer tracing;
+  Buffer timing;
+  Buffer direct;
+  Buffer prefix;
+  Buffer prefix_upper;
+  Buffer egl;
+  Buffer glx;
+  Buffer wgl;
+  Buffer modules;
+  Buffer module_types_header;
+  std::vector<ModuleOutput> module_outputs;
+};
+
+enum Option
+{
+  API,
+  CORE,
+  VERSION,
+  EXTENSIONS,
+  TEMPLATE,
+  OUTPUT,
+  SPEC,
+  CACHE,
+  BUILD_CACHE,
+  SPLIT,
+  TYPES_HEADER,
+  MODULAR,
+  PROFILING,
+  TRACING,
+  USAGE,
+  DIRECT,
+  SCAN,
+  BATCH,
+  JOBS,
+  FINGERPRINT,
+  STATS,
+  STATS_JSON,
+  HELP
+};
+
+const option options[] =
+{
+  { "api", 1, NULL, Option::API },
+  { "core", 0, NULL, Option::CORE },
+  { "version", 1, NULL, Option::VERSION },
+  { "extensions", 1, NULL, Option::EXTENSIONS },
+  { "template", 1, NULL, Option::TEMPLATE },
+  { "output", 1, NULL, Option::OUTPUT },
+  { "spec", 1, NULL, Option::SPEC },
+  { "cache", 1, NULL, Option::CACHE },
+  { "build-cache", 0, NULL, Option::BUILD_CACHE },
+  { "split", 0, NULL, Option::SPLIT },
+  { "types-header", 0, NULL, Option::TYPES_HEADER },
+  { "modular", 0, NULL, Option::MODULAR },
+  { "profiling", 0, NULL, Option::PROFILING },
+  { "tracing", 0, NULL, Option::TRACING },
+  { "usage", 1, NULL, Option::USAGE },
+  { "direct", 1, NULL, Option::DIRECT },
+  { "scan", 1, NULL, Option::SCAN },
+  { "batch", 1, NULL, Option::BATCH },
+  { "jobs", 1, NULL, Option::JOBS },
+  { "fingerprint", 0, NULL, Option::FINGERPRINT },
+  { "stats", 0, NULL, Option::STATS },
+  { "stats-json", 1, NULL, Option::STATS_JSON },
+  { "help", 0, NULL, Option::HELP },
+  { NULL, 0, NULL, 0 }
 };
 
 void usage()
 {
   std::puts("Usage: greg [OPTION]...");
   std::puts("Options:");
-  std::puts("  --api=API                client API to generate loader for");
+  std::puts("  --api=API                client or window system API to generate loader for");
   std::puts("  --core                   use the core profile (OpenGL only)");
   std::puts("  --version=VERSION        highest API version to generate for");
   std::puts("  --extensions=EXTENSIONS  list of extensions to generate for");
+  std::puts("  --template=PATH          template file to generate from");
+  std::puts("  --output=PATH            file to write the generated loader to");
+  std::puts("  --spec=PATH              registry XML file to generate from");
+  std::puts("  --cache=PATH             registry cache to use or build");
+  std::puts("  --build-cache            build the registry cache and exit");
+  std::puts("  --split                  put the implementation in a separate source file");
+  std::puts("  --types-header           put types and enumerations in a separate header");
+  std::puts("  --modular                put each version and extension in its own header");
+  std::puts("  --profiling              count calls to and time spent in each function");
+  std::puts("  --tracing                record calls and their arguments in a buffer");
+  std::puts("  --usage=PATH             call counts to order the function pointer table by");
+  std::puts("  --direct=VERSION         link functions up to this version directly");
+  std::puts("  --scan=DIR               include only functions and enums used by sources in DIR");
+  std::puts("  --batch=PATH             file listing one target per line");
+  std::puts("  --jobs=COUNT             number of targets to generate at once");
+  std::puts("  --fingerprint            skip targets whose inputs are unchanged");
+  std::puts("  --stats                  print time and memory used by each phase");
+  std::puts("  --stats-json=PATH        write the same statistics as JSON");
   std::puts("  -h, --help               show this help");
 }
 
@@ -118,15 +689,86 @@ void error(const char* message)
   std::exit(EXIT_FAILURE);
 }
 
+// Returns the directory part of the specified path, including the final
+// separator, or an empty string if there is none
+//
+wire::string directory_name(const wire::string& path)
+{
+  const size_t separator = path.find_last_of("/\\");
+  if (separator == wire::string::npos)
+    return "";
+
+  return path.substr(0, separator + 1);
+}
+
+// Returns the file name part of the specified path
+//
+wire::string file_name(const wire::string& path)
+{
+  return path.substr(directory_name(path).size());
+}
+
+// Returns the specified path with the specified suffix, if present,
+// replaced by the specified replacement
+//
+wire::string replace_suffix(const wire::string& path,
+                            const char* suffix,
+                            const char* replacement)
+{
+  wire::string result = path;
+  if (result.ends_with(suffix))
+    result.resize(result.size() - std::strlen(suffix));
+
+  return result + replacement;
+}
+
+// Returns the path of the implementation source of the specified target
+//
+wire::string source_path(const Target& target)
+{
+  return replace_suffix(target.output_path, ".h", ".c");
+}
+
+// Returns the directory of the version and extension headers of the
+// specified target
+//
+wire::string module_directory(const Target& target)
+{
+  return directory_name(target.output_path) + "greg/";
+}
+
+// Returns the path of the types and enumerations header of the specified
+// target
+// Modular targets keep it with the headers that include it
+//
+wire::string types_path(const Target& target)
+{
+  if (target.modular)
+    return module_directory(target) + "types.h";
+
+  return replace_suffix(target.output_path, ".h", "_types.h");
+}
+
+// Creates the specified directory unless it already exists
+//
+void make_directory(const wire::string& path)
+{
+#if defined(_WIN32)
+  const int result = _mkdir(path.c_str());
+#else
+  const int result = mkdir(path.c_str(), 0755);
+#endif
+
+  if (result != 0 && errno != EEXIST)
+    error("Failed to create directory");
+}
+
 // Return the API name of a <type> element
-// Not all <type> elements have api attributes
+// Elements without an api attribute apply to every API and have an empty name
 //
 const char* api_name(const pugi::xml_node tn)
 {
-  if (const pugi::xml_attribute aa = tn.attribute("api"))
-    return aa.value();
-  else
-    return "gl";
+  return tn.attribute("api").value();
 }
 
 // Return the type name of a <type> tag
@@ -175,6 +817,37 @@ wire::string scrape_proto_text(const pugi::xml_node node)
   return result;
 }
 
+// Return a complete C parameter declaration from a <command> element, with
+// the parameters named p0, p1 and so on
+// The names from the spec are not used as some of them, like near and far,
+// are defined as macros by windows.h
+// The <name> element is always last in a <param> element
+//
+wire::string command_named_params(const pugi::xml_node node)
+{
+  wire::string result;
+  unsigned int index = 0;
+
+  for (const pugi::xml_node pn : node.children("param"))
+  {
+    if (!result.empty())
+      result += ", ";
+
+    wire::string param = scrape_proto_text(pn);
+    if (!param.ends_with("*") && !param.ends_with(" "))
+      param += ' ';
+
+    std::ostringstream name;
+    name << 'p' << index++;
+    result += param + name.str();
+  }
+
+  if (result.empty())
+    result = "void";
+
+  return result;
+}
+
 // Return a complete C parameter declaration from a <command> element
 //
 wire::string command_params(const pugi::xml_node node)
@@ -195,305 +868,3245 @@ wire::string command_params(const pugi::xml_node node)
   return result;
 }
 
-// Adds items from a <require> element to the specified manifest
+// Stores the specified text in the text pool of the specified registry
+//
+const char* store_text(Registry& registry, const wire::string& text)
+{
+  registry.text.push_back(text);
+  return registry.text.back().c_str();
+}
+
+// Returns the symbols of the names of the child elements of the specified type
 //
-void add_to_manifest(Manifest& manifest, const pugi::xml_node node)
+std::vector<Symbol> child_symbols(SymbolTable& symbols,
+                                  const pugi::xml_node node,
+                                  const char* type)
 {
-  for (const pugi::xml_node child : node.children("type"))
-    manifest.types.insert(child.attribute("name").value());
+  std::vector<Symbol> result;
 
-  for (const pugi::xml_node child : node.children("enum"))
-    manifest.enums.insert(child.attribute("name").value());
+  for (const pugi::xml_node child : node.children(type))
+    result.push_back(symbols.intern(child.attribute("name").value()));
 
-  for (const pugi::xml_node child : node.children("command"))
-    manifest.commands.insert(child.attribute("name").value());
+  return result;
 }
 
-// Removes items from a <remove> element from the specified manifest
+// Returns the contents of a <require> or <remove> element
 //
-void remove_from_manifest(Manifest& manifest, const pugi::xml_node node)
+InterfaceSpec load_interface(Registry& registry, const pugi::xml_node node)
 {
-  for (const pugi::xml_node tn : node.children("type"))
-    manifest.types.erase(tn.attribute("name").value());
-
-  for (const pugi::xml_node en : node.children("enum"))
-    manifest.enums.erase(en.attribute("name").value());
+  const InterfaceSpec is =
+  {
+    node.attribute("profile").value(),
+    child_symbols(registry.type_symbols, node, "type"),
+    child_symbols(registry.enum_symbols, node, "enum"),
+    child_symbols(registry.command_symbols, node, "command")
+  };
 
-  for (const pugi::xml_node cn : node.children("command"))
-    manifest.commands.erase(cn.attribute("name").value());
+  return is;
 }
 
-// Applies a <feature> or <extension> element to the specified manifest
+// Loads the <require> and <remove> elements of a <feature> or <extension>
 //
-void update_manifest(Manifest& manifest,
-                     const Target& target,
-                     const pugi::xml_node node)
+template <typename T>
+void load_interfaces(Registry& registry, T& spec, const pugi::xml_node node)
 {
   for (const pugi::xml_node rn : node.children("require"))
-    add_to_manifest(manifest, rn);
+    spec.required.push_back(load_interface(registry, rn));
 
-  // Apply <remove> tags for the selected profile
   for (const pugi::xml_node rn : node.children("remove"))
-  {
-    if (rn.attribute("profile").value() == target.profile)
-      remove_from_manifest(manifest, rn);
-  }
+    spec.removed.push_back(load_interface(registry, rn));
 }
 
-// Generates a manifest from the specified document according to the
-// specified target
+// Builds a registry from the specified document in a single pass
 //
-Manifest generate_manifest(const Target& target, const pugi::xml_document& spec)
+Registry load_registry(const pugi::xml_document& spec)
 {
-  Manifest manifest;
+  Registry registry;
 
-  for (const auto ref : spec.select_nodes("/registry/feature"))
+  const pugi::xml_node root = spec.child("registry");
+
+  for (const pugi::xml_node fn : root.children("feature"))
   {
-    const pugi::xml_node fn = ref.node();
-    const Version version(fn.attribute("number").as_string());
+    FeatureSpec feature;
+    feature.api = fn.attribute("api").value();
+    feature.name = fn.attribute("name").value();
+    feature.version = Version(fn.attribute("number").as_string());
+    load_interfaces(registry, feature, fn);
+    registry.features.push_back(feature);
+  }
 
-    if (fn.attribute("api").value() == target.api && version <= target.version)
+  for (const pugi::xml_node esn : root.children("extensions"))
+  {
+    for (const pugi::xml_node en : esn.children("extension"))
     {
-      update_manifest(manifest, target, fn);
-
-      const Feature feature = { fn.attribute("name").value(), version };
-      manifest.features.push_back(feature);
+      ExtensionSpec extension;
+      extension.name = en.attribute("name").value();
+      extension.supported = en.attribute("supported").value();
+      load_interfaces(registry, extension, en);
+      registry.extensions.push_back(extension);
     }
   }
 
-  for (const auto ref : spec.select_nodes("/registry/extensions/extension"))
+  for (const pugi::xml_node tsn : root.children("types"))
   {
-    const pugi::xml_node en = ref.node();
-    const char* name = en.attribute("name").value();
-
-    if (target.extensions.count(name))
+    for (const pugi::xml_node tn : tsn.children("type"))
     {
-      const wire::string n = target.api + target.profile;
-      const wire::strings p =
-        wire::string(en.attribute("supported").value()).split("|");
+      TypeSpec type;
+      type.name = type_name(tn);
+      type.api = api_name(tn);
+      type.text = store_text(registry, scrape_type_text(tn));
+      type.symbol = registry.type_symbols.intern(type.name);
+      type.dependency = no_symbol;
 
-      if (std::find(p.begin(), p.end(), n) == p.end())
-      {
-        std::printf("Excluding unsupported extension %s\n", name);
-        continue;
-      }
+      if (const pugi::xml_attribute ra = tn.attribute("requires"))
+        type.dependency = registry.type_symbols.intern(ra.value());
 
-      update_manifest(manifest, target, en);
-      manifest.extensions.push_back(name);
+      registry.types.push_back(type);
     }
   }
 
-  for (const auto ref : spec.select_nodes("/registry/commands/command"))
+  for (const pugi::xml_node esn : root.children("enums"))
   {
-    const pugi::xml_node cn = ref.node();
-
-    if (manifest.commands.count(cn.child("proto").child_value("name")))
+    for (const pugi::xml_node en : esn.children("enum"))
     {
+      const char* name = en.attribute("name").value();
+      const EnumSpec e =
+      {
+        name,
+        en.attribute("value").value(),
+        registry.enum_symbols.intern(name)
+      };
+
+      registry.enums.push_back(e);
+    }
+  }
+
+  for (const pugi::xml_node csn : root.children("commands"))
+  {
+    for (const pugi::xml_node cn : csn.children("command"))
+    {
+      CommandSpec command;
+      command.name = cn.child("proto").child_value("name");
+      command.proto = store_text(registry, scrape_proto_text(cn.child("proto")));
+      command.params = store_text(registry, command_params(cn));
+      command.named_params = store_text(registry, command_named_params(cn));
+      command.param_count = 0;
+      command.symbol = registry.command_symbols.intern(command.name);
+      command.alias = no_symbol;
+
+      if (const pugi::xml_node an = cn.child("alias"))
+        command.alias = registry.command_symbols.intern(an.attribute("name").value());
+
+      if (const pugi::xml_node tn = cn.child("proto").child("ptype"))
+        command.param_types.push_back(registry.type_symbols.intern(tn.child_value()));
+
       for (const pugi::xml_node pn : cn.children("param"))
       {
+        command.param_count++;
+
         if (const pugi::xml_node tn = pn.child("ptype"))
-          manifest.types.insert(tn.child_value());
+          command.param_types.push_back(registry.type_symbols.intern(tn.child_value()));
+      }
+
+      registry.commands.push_back(command);
+    }
+  }
+
+  return registry;
+}
+
+// An element of the registry, or one of its children, found by scanning the
+// text of the spec, with the offsets of its start, the end of its start tag
+// and its end
+//
+struct ElementSpan
+{
+  std::string name;
+  size_t depth;
+  size_t start;
+  size_t content;
+  size_t end;
+};
+
+// Returns the offset just past the end of the specified string in the
+// specified text, or the size of the text if it's not found
+//
+size_t skip_past(const char* data, size_t size, size_t offset, const char* string)
+{
+  const size_t length = std::strlen(string);
+
+  for (;  offset + length <= size;  offset++)
+  {
+    if (std::memcmp(data + offset, string, length) == 0)
+      return offset + length;
+  }
+
+  return size;
+}
+
+// Returns the spans of the children of the root element of the specified
+// text and of their children, in document order
+// Only the nesting of tags is tracked, so no DOM nodes are built
+//
+std::vector<ElementSpan> scan_elements(const char* data, size_t size)
+{
+  std::vector<ElementSpan> spans;
+  std::vector<size_t> open;
+  const size_t none = (size_t) -1;
+  size_t offset = 0;
+
+  for (;;)
+  {
+    const char* c = (const char*) std::memchr(data + offset, '<', size - offset);
+    if (!c)
+      break;
+
+    const size_t start = c - data;
+
+    if (std::strncmp(c, "<!--", 4) == 0)
+      offset = skip_past(data, size, start + 4, "-->");
+    else if (std::strncmp(c, "<![CDATA[", 9) == 0)
+      offset = skip_past(data, size, start + 9, "]]>");
+    else if (c[1] == '?' || c[1] == '!')
+      offset = skip_past(data, size, start + 2, ">");
+    else if (c[1] == '/')
+    {
+      offset = skip_past(data, size, start + 2, ">");
+
+      if (open.empty())
+        break;
+
+      if (open.back() != none)
+        spans[open.back()].end = offset;
+
+      open.pop_back();
+    }
+    else
+    {
+      // Find the end of the start tag, skipping quoted attribute values
+      char quote = 0;
+      offset = start + 1;
+
+      for (;  offset < size;  offset++)
+      {
+        if (quote)
+        {
+          if (data[offset] == quote)
+            quote = 0;
+        }
+        else if (data[offset] == '"' || data[offset] == '\'')
+          quote = data[offset];
+        else if (data[offset] == '>')
+          break;
+      }
+
+      offset = std::min(offset + 1, size);
+
+      const bool empty = data[offset - 2] == '/';
+      const size_t depth = open.size();
+      size_t index = none;
+
+      if (depth == 1 || depth == 2)
+      {
+        size_t length = 1;
+        while (start + length < size && !std::isspace((unsigned char) data[start + length]) &&
+               data[start + length] != '>' && data[start + length] != '/')
+        {
+          length++;
+        }
+
+        const ElementSpan span = { std::string(c + 1, length - 1), depth, start, offset, offset };
+        index = spans.size();
+        spans.push_back(span);
+      }
+
+      if (!empty)
+        open.push_back(index);
+    }
+  }
+
+  return spans;
+}
+
+// Returns the value of the specified attribute in the start tag of the
+// specified element, or an empty string if it has none
+//
+std::string span_attribute(const char* data, const ElementSpan& span, const char* name)
+{
+  const std::string tag(data + span.start, span.content - span.start);
+  const std::string pattern = std::string(name) + "=\"";
+
+  for (size_t offset = tag.find(pattern);  offset != std::string::npos;
+       offset = tag.find(pattern, offset + 1))
+  {
+    if (std::isspace((unsigned char) tag[offset - 1]))
+    {
+      const size_t first = offset + pattern.size();
+      return tag.substr(first, tag.find('"', first) - first);
+    }
+  }
+
+  return std::string();
+}
+
+// Shrinks the specified spec text in place to the elements the specified
+// targets may use and returns its new size
+// Features of other APIs or later versions, extensions not requested and
+// the enums and commands none of the remaining elements mention are left
+// out, along with elements the registry doesn't read, so the DOM built
+// from the result is only as large as the targets need
+//
+size_t filter_spec(char* data, size_t size, const std::vector<Target>& targets)
+{
+  const std::vector<ElementSpan> spans = scan_elements(data, size);
+  std::vector<bool> keep(spans.size(), false);
+  std::unordered_set<std::string> names;
+
+  for (size_t i = 0;  i < spans.size();  i++)
+  {
+    const ElementSpan& span = spans[i];
+
+    if (span.depth == 1 && span.name == "feature")
+    {
+      const std::string api = span_attribute(data, span, "api");
+      const Version version(span_attribute(data, span, "number").c_str());
+
+      for (const Target& target : targets)
+      {
+        if (target.api == api.c_str() && version <= target.version)
+          keep[i] = true;
+      }
+    }
+    else if (span.depth == 2 && span.name == "extension")
+    {
+      const wire::string name = span_attribute(data, span, "name");
+
+      for (const Target& target : targets)
+      {
+        if (target.extensions.count(name))
+          keep[i] = true;
+      }
+    }
+    else
+      continue;
+
+    if (!keep[i])
+      continue;
+
+    // Parse only the kept features and extensions to collect what they use
+    pugi::xml_document element;
+    if (!element.load_buffer(data + span.start, span.end - span.start))
+      error("Failed to parse file");
+
+    for (const pugi::xml_node rn : element.first_child().children())
+    {
+      for (const pugi::xml_node child : rn.children())
+        names.insert(child.attribute("name").value());
+    }
+  }
+
+  for (size_t i = 0;  i < spans.size();  i++)
+  {
+    const ElementSpan& span = spans[i];
+
+    if (span.depth == 1)
+      keep[i] = keep[i] || span.name == "types";
+    else if (span.name == "enum")
+      keep[i] = names.count(span_attribute(data, span, "name")) > 0;
+    else if (span.name == "command")
+    {
+      const size_t first = skip_past(data, span.end, span.content, "<name>");
+      const size_t last = skip_past(data, span.end, first, "</name>") - 7;
+      keep[i] = last > first && names.count(std::string(data + first, last - first));
+    }
+  }
+
+  // The kept text is moved towards the start, which never overtakes the
+  // text still to be moved, as only the root start tag is replaced
+  size_t size_kept = 0;
+  const auto append = [&](const char* text, size_t length)
+  {
+    std::memmove(data + size_kept, text, length);
+    size_kept += length;
+  };
+
+  append("<registry>", 10);
+
+  for (size_t i = 0;  i < spans.size();  i++)
+  {
+    const ElementSpan& span = spans[i];
+    if (span.depth != 1)
+      continue;
+
+    if (keep[i])
+      append(data + span.start, span.end - span.start);
+    else if (span.name == "enums" || span.name == "commands" || span.name == "extensions")
+    {
+      // Empty elements end with their start tag
+      if (span.end == span.content)
+      {
+        append(data + span.start, span.end - span.start);
+        continue;
+      }
+
+      append(data + span.start, span.content - span.start);
+
+      for (size_t j = i + 1;  j < spans.size() && spans[j].depth == 2;  j++)
+      {
+        if (keep[j])
+          append(data + spans[j].start, spans[j].end - spans[j].start);
       }
+
+      const std::string end = "</" + span.name + ">";
+      append(end.c_str(), end.size());
+    }
+  }
+
+  append("</registry>", 11);
+  return size_kept;
+}
+
+const uint64_t hash_basis = 14695981039346656037ull;
+
+// Returns the 64-bit FNV-1a hash of the specified data
+// Passing the hash of preceding data continues that hash
+//
+uint64_t hash_data(const char* data, size_t size, uint64_t hash = hash_basis)
+{
+  for (size_t i = 0;  i < size;  i++)
+  {
+    hash ^= (unsigned char) data[i];
+    hash *= 1099511628211ull;
+  }
+
+  return hash;
+}
+
+// The registry cache is a single block of native-endian 32-bit records that
+// can be used in place once mapped
+// String fields are offsets into the string section, symbol ranges index
+// the name section and other ranges index the symbol or interface sections
+// Bump the version whenever the layout or the content of the registry changes
+//
+const char cache_magic[8] = { 'G', 'R', 'E', 'G', 'R', 'E', 'G', 0 };
+const uint32_t cache_version = 6;
+
+struct CacheRange
+{
+  uint32_t first;
+  uint32_t count;
+};
+
+struct CacheHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t size;
+  uint64_t spec_hash;
+  CacheRange strings;
+  CacheRange names;
+  CacheRange symbols;
+  CacheRange interfaces;
+  CacheRange features;
+  CacheRange extensions;
+  CacheRange types;
+  CacheRange enums;
+  CacheRange commands;
+  CacheRange type_symbols;
+  CacheRange enum_symbols;
+  CacheRange command_symbols;
+};
+
+struct CacheInterface
+{
+  uint32_t profile;
+  CacheRange types;
+  CacheRange enums;
+  CacheRange commands;
+};
+
+struct CacheFeature
+{
+  uint32_t api;
+  uint32_t name;
+  uint32_t major;
+  uint32_t minor;
+  CacheRange required;
+  CacheRange removed;
+};
+
+struct CacheExtension
+{
+  uint32_t name;
+  uint32_t supported;
+  CacheRange required;
+  CacheRange removed;
+};
+
+struct CacheType
+{
+  uint32_t name;
+  uint32_t api;
+  uint32_t text;
+  uint32_t symbol;
+  uint32_t dependency;
+};
+
+struct CacheEnum
+{
+  uint32_t name;
+  uint32_t value;
+  uint32_t symbol;
+};
+
+struct CacheCommand
+{
+  uint32_t name;
+  uint32_t proto;
+  uint32_t params;
+  uint32_t named_params;
+  uint32_t param_count;
+  uint32_t symbol;
+  uint32_t alias;
+  CacheRange param_types;
+};
+
+// Flattens a registry into the sections of a registry cache
+//
+class CacheWriter
+{
+public:
+  void add_registry(const Registry& registry)
+  {
+    type_symbols = add_names(registry.type_symbols);
+    enum_symbols = add_names(registry.enum_symbols);
+    command_symbols = add_names(registry.command_symbols);
+
+    for (const FeatureSpec& fs : registry.features)
+    {
+      const CacheFeature feature =
+      {
+        add_string(fs.api),
+        add_string(fs.name),
+        fs.version.major,
+        fs.version.minor,
+        add_interfaces(fs.required),
+        add_interfaces(fs.removed)
+      };
+
+      features.push_back(feature);
+    }
+
+    for (const ExtensionSpec& es : registry.extensions)
+    {
+      const CacheExtension extension =
+      {
+        add_string(es.name),
+        add_string(es.supported),
+        add_interfaces(es.required),
+        add_interfaces(es.removed)
+      };
+
+      extensions.push_back(extension);
+    }
+
+    for (const TypeSpec& ts : registry.types)
+    {
+      const CacheType type =
+      {
+        add_string(ts.name),
+        add_string(ts.api),
+        add_string(ts.text),
+        ts.symbol,
+        ts.dependency
+      };
+
+      types.push_back(type);
+    }
+
+    for (const EnumSpec& es : registry.enums)
+    {
+      const CacheEnum e = { add_string(es.name), add_string(es.value), es.symbol };
+      enums.push_back(e);
+    }
+
+    for (const CommandSpec& cs : registry.commands)
+    {
+      const CacheCommand command =
+      {
+        add_string(cs.name),
+        add_string(cs.proto),
+        add_string(cs.params),
+        add_string(cs.named_params),
+        cs.param_count,
+        cs.symbol,
+        cs.alias,
+        add_symbols(cs.param_types)
+      };
+
+      commands.push_back(command);
+    }
+  }
+  bool write(const char* path, uint64_t spec_hash) const
+  {
+    CacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, cache_magic, sizeof(cache_magic));
+    header.version = cache_version;
+    header.spec_hash = spec_hash;
+    header.type_symbols = type_symbols;
+    header.enum_symbols = enum_symbols;
+    header.command_symbols = command_symbols;
+
+    uint32_t offset = sizeof(header);
+    header.names = section(offset, names);
+    header.symbols = section(offset, symbols);
+    header.interfaces = section(offset, interfaces);
+    header.features = section(offset, features);
+    header.extensions = section(offset, extensions);
+    header.types = section(offset, types);
+    header.enums = section(offset, enums);
+    header.commands = section(offset, commands);
+    header.strings = section(offset, strings);
+    header.size = offset;
+
+    std::ofstream stream(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (stream.fail())
+      return false;
+
+    stream.write((const char*) &header, sizeof(header));
+    write_section(stream, names);
+    write_section(stream, symbols);
+    write_section(stream, interfaces);
+    write_section(stream, features);
+    write_section(stream, extensions);
+    write_section(stream, types);
+    write_section(stream, enums);
+    write_section(stream, commands);
+    write_section(stream, strings);
+
+    return !stream.fail();
+  }
+private:
+  uint32_t add_string(const char* string)
+  {
+    const auto entry = string_offsets.find(string);
+    if (entry != string_offsets.end())
+      return entry->second;
+
+    const uint32_t offset = (uint32_t) strings.size();
+    strings.insert(strings.end(), string, string + std::strlen(string) + 1);
+    string_offsets[string] = offset;
+    return offset;
+  }
+  CacheRange add_names(const SymbolTable& table)
+  {
+    const CacheRange range = { (uint32_t) names.size(), (uint32_t) table.size() };
+
+    for (const char* name : table.names)
+      names.push_back(add_string(name));
+
+    return range;
+  }
+  CacheRange add_symbols(const std::vector<Symbol>& list)
+  {
+    const CacheRange range = { (uint32_t) symbols.size(), (uint32_t) list.size() };
+    symbols.insert(symbols.end(), list.begin(), list.end());
+    return range;
+  }
+  CacheRange add_interfaces(const std::vector<InterfaceSpec>& list)
+  {
+    const CacheRange range = { (uint32_t) interfaces.size(), (uint32_t) list.size() };
+
+    for (const InterfaceSpec& is : list)
+    {
+      const CacheInterface ci =
+      {
+        add_string(is.profile),
+        add_symbols(is.types),
+        add_symbols(is.enums),
+        add_symbols(is.commands)
+      };
+
+      interfaces.push_back(ci);
+    }
+
+    return range;
+  }
+  template <typename T>
+  static CacheRange section(uint32_t& offset, const std::vector<T>& items)
+  {
+    const CacheRange range = { offset, (uint32_t) items.size() };
+    offset += (uint32_t) (items.size() * sizeof(T));
+    return range;
+  }
+  template <typename T>
+  static void write_section(std::ostream& stream, const std::vector<T>& items)
+  {
+    if (!items.empty())
+      stream.write((const char*) &items[0], items.size() * sizeof(T));
+  }
+  std::map<std::string, uint32_t> string_offsets;
+  std::vector<char> strings;
+  std::vector<uint32_t> names;
+  std::vector<Symbol> symbols;
+  std::vector<CacheInterface> interfaces;
+  std::vector<CacheFeature> features;
+  std::vector<CacheExtension> extensions;
+  std::vector<CacheType> types;
+  std::vector<CacheEnum> enums;
+  std::vector<CacheCommand> commands;
+  CacheRange type_symbols;
+  CacheRange enum_symbols;
+  CacheRange command_symbols;
+};
+
+// Rebuilds a registry from a mapped registry cache
+// The registry points into the cache, which must therefore outlive it
+//
+class CacheReader
+{
+public:
+  CacheReader(const char* data, size_t size): data(data), size(size), valid(true)
+  {
+  }
+  // Returns false if the cache is malformed or for a different spec
+  bool read_registry(Registry& registry, uint64_t spec_hash)
+  {
+    if (size < sizeof(CacheHeader))
+      return false;
+
+    const CacheHeader& header = *(const CacheHeader*) data;
+    if (std::memcmp(header.magic, cache_magic, sizeof(cache_magic)) != 0 ||
+        header.version != cache_version ||
+        header.size != size ||
+        header.spec_hash != spec_hash)
+    {
+      return false;
+    }
+
+    names = section<uint32_t>(header.names);
+    symbols = section<Symbol>(header.symbols);
+    interfaces = section<CacheInterface>(header.interfaces);
+    strings = section<char>(header.strings);
+    string_count = header.strings.count;
+    name_count = header.names.count;
+    symbol_count = header.symbols.count;
+    interface_count = header.interfaces.count;
+
+    if (!valid || !string_count || strings[string_count - 1] != '\0')
+      return false;
+
+    const CacheFeature* features = section<CacheFeature>(header.features);
+    const CacheExtension* extensions = section<CacheExtension>(header.extensions);
+    const CacheType* types = section<CacheType>(header.types);
+    const CacheEnum* enums = section<CacheEnum>(header.enums);
+    const CacheCommand* commands = section<CacheCommand>(header.commands);
+    if (!valid)
+      return false;
+
+    read_symbols(registry.type_symbols, header.type_symbols);
+    read_symbols(registry.enum_symbols, header.enum_symbols);
+    read_symbols(registry.command_symbols, header.command_symbols);
+    type_limit = registry.type_symbols.size();
+    enum_limit = registry.enum_symbols.size();
+    command_limit = registry.command_symbols.size();
+
+    for (uint32_t i = 0;  i < header.features.count;  i++)
+    {
+      FeatureSpec feature;
+      feature.api = string(features[i].api);
+      feature.name = string(features[i].name);
+      feature.version = Version(features[i].major, features[i].minor);
+      feature.required = interface_list(features[i].required);
+      feature.removed = interface_list(features[i].removed);
+      registry.features.push_back(feature);
     }
+
+    for (uint32_t i = 0;  i < header.extensions.count;  i++)
+    {
+      ExtensionSpec extension;
+      extension.name = string(extensions[i].name);
+      extension.supported = string(extensions[i].supported);
+      extension.required = interface_list(extensions[i].required);
+      extension.removed = interface_list(extensions[i].removed);
+      registry.extensions.push_back(extension);
+    }
+
+    for (uint32_t i = 0;  i < header.types.count;  i++)
+    {
+      TypeSpec type;
+      type.name = string(types[i].name);
+      type.api = string(types[i].api);
+      type.text = string(types[i].text);
+      type.symbol = symbol(types[i].symbol, type_limit);
+      type.dependency = no_symbol;
+
+      if (types[i].dependency != no_symbol)
+        type.dependency = symbol(types[i].dependency, type_limit);
+
+      registry.types.push_back(type);
+    }
+
+    for (uint32_t i = 0;  i < header.enums.count;  i++)
+    {
+      const EnumSpec e =
+      {
+        string(enums[i].name),
+        string(enums[i].value),
+        symbol(enums[i].symbol, enum_limit)
+      };
+
+      registry.enums.push_back(e);
+    }
+
+    for (uint32_t i = 0;  i < header.commands.count;  i++)
+    {
+      CommandSpec command;
+      command.name = string(commands[i].name);
+      command.proto = string(commands[i].proto);
+      command.params = string(commands[i].params);
+      command.named_params = string(commands[i].named_params);
+      command.param_count = commands[i].param_count;
+      command.symbol = symbol(commands[i].symbol, command_limit);
+      command.alias = no_symbol;
+
+      if (commands[i].alias != no_symbol)
+        command.alias = symbol(commands[i].alias, command_limit);
+
+      command.param_types = symbol_list(commands[i].param_types, type_limit);
+      registry.commands.push_back(command);
+    }
+
+    return valid;
+  }
+private:
+  template <typename T>
+  const T* section(const CacheRange& range)
+  {
+    if (range.first % sizeof(uint32_t) ||
+        range.first > size ||
+        range.count > (size - range.first) / sizeof(T))
+    {
+      valid = false;
+      return NULL;
+    }
+
+    return (const T*) (data + range.first);
+  }
+  bool check(const CacheRange& range, uint32_t count)
+  {
+    if (range.first > count || range.count > count - range.first)
+      valid = false;
+
+    return valid;
+  }
+  const char* string(uint32_t offset)
+  {
+    if (offset >= string_count)
+    {
+      valid = false;
+      return "";
+    }
+
+    return strings + offset;
+  }
+  Symbol symbol(Symbol value, size_t limit)
+  {
+    if (value >= limit)
+    {
+      valid = false;
+      return 0;
+    }
+
+    return value;
+  }
+  void read_symbols(SymbolTable& table, const CacheRange& range)
+  {
+    if (check(range, name_count))
+    {
+      for (uint32_t i = 0;  i < range.count;  i++)
+        table.intern(string(names[range.first + i]));
+    }
+
+    // Duplicate names would shift every later symbol
+    if (table.size() != range.count)
+      valid = false;
+  }
+  std::vector<Symbol> symbol_list(const CacheRange& range, size_t limit)
+  {
+    std::vector<Symbol> result;
+
+    if (check(range, symbol_count))
+    {
+      for (uint32_t i = 0;  i < range.count;  i++)
+        result.push_back(symbol(symbols[range.first + i], limit));
+    }
+
+    return result;
+  }
+  std::vector<InterfaceSpec> interface_list(const CacheRange& range)
+  {
+    std::vector<InterfaceSpec> result;
+
+    if (check(range, interface_count))
+    {
+      for (uint32_t i = 0;  i < range.count;  i++)
+      {
+        const CacheInterface& ci = interfaces[range.first + i];
+        const InterfaceSpec is =
+        {
+          string(ci.profile),
+          symbol_list(ci.types, type_limit),
+          symbol_list(ci.enums, enum_limit),
+          symbol_list(ci.commands, command_limit)
+        };
+
+        result.push_back(is);
+      }
+    }
+
+    return result;
+  }
+  const char* data;
+  size_t size;
+  bool valid;
+  const char* strings;
+  const uint32_t* names;
+  const Symbol* symbols;
+  const CacheInterface* interfaces;
+  uint32_t string_count;
+  uint32_t name_count;
+  uint32_t symbol_count;
+  uint32_t interface_count;
+  size_t type_limit;
+  size_t enum_limit;
+  size_t command_limit;
+};
+
+// Adds the specified owner to the owners of an item, unless it is already
+// the last of them
+//
+void add_owner(Owners& owners, Owner owner)
+{
+  if (owners.empty() || owners.back() != owner)
+    owners.push_back(owner);
+}
+
+// Adds items from a <require> element to the specified manifest
+// The specified feature or extension becomes one of the owners of each item
+//
+void add_to_manifest(Manifest& manifest, const InterfaceSpec& is, Owner owner)
+{
+  for (const Symbol symbol : is.types)
+    manifest.types.set(symbol);
+
+  for (const Symbol symbol : is.enums)
+  {
+    add_owner(manifest.enum_owners[symbol], owner);
+    manifest.enums.set(symbol);
+  }
+
+  for (const Symbol symbol : is.commands)
+  {
+    add_owner(manifest.command_owners[symbol], owner);
+    manifest.commands.set(symbol);
+  }
+}
+
+// Removes items from a <remove> element from the specified manifest
+// Removed items lose their owners, so any later feature re-adding them
+// becomes their first owner
+//
+void remove_from_manifest(Manifest& manifest, const InterfaceSpec& is)
+{
+  for (const Symbol symbol : is.types)
+    manifest.types.reset(symbol);
+
+  for (const Symbol symbol : is.enums)
+  {
+    manifest.enum_owners[symbol].clear();
+    manifest.enums.reset(symbol);
+  }
+
+  for (const Symbol symbol : is.commands)
+  {
+    manifest.command_owners[symbol].clear();
+    manifest.commands.reset(symbol);
+  }
+}
+
+// Applies a <feature> or <extension> element to the specified manifest
+//
+template <typename T>
+void update_manifest(Manifest& manifest, const Target& target, const T& spec)
+{
+  const Owner owner = manifest.features.size() + manifest.extensions.size();
+
+  for (const InterfaceSpec& is : spec.required)
+    add_to_manifest(manifest, is, owner);
+
+  // Apply <remove> tags for the selected profile
+  for (const InterfaceSpec& is : spec.removed)
+  {
+    if (is.profile == target.profile)
+      remove_from_manifest(manifest, is);
+  }
+}
+
+// Returns the text of the specified file
+//
+wire::string read_file(const char* path)
+{
+  std::ifstream stream(path, std::ios::in | std::ios::binary);
+  if (stream.fail())
+    error("File not found");
+
+  std::ostringstream contents;
+  contents << stream.rdbuf();
+  return contents.str();
+}
+
+// Appends the paths of the C, C++ and Objective-C sources in the specified
+// directory and its subdirectories, skipping hidden entries
+//
+void find_sources(const wire::string& directory, std::vector<wire::string>& paths)
+{
+  static const char* suffixes[] =
+  {
+    ".c", ".cc", ".cpp", ".cxx", ".h", ".hh", ".hpp", ".hxx", ".inl", ".m", ".mm", NULL
+  };
+
+  std::vector<std::pair<wire::string, bool>> entries;
+
+#if defined(_WIN32)
+  WIN32_FIND_DATAA data;
+  const HANDLE handle = FindFirstFileA((directory + "/*").c_str(), &data);
+  if (handle == INVALID_HANDLE_VALUE)
+    error("Failed to open directory");
+
+  do
+  {
+    const bool is_directory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+    entries.push_back(std::make_pair(wire::string(data.cFileName), is_directory));
+  }
+  while (FindNextFileA(handle, &data));
+
+  FindClose(handle);
+#else
+  DIR* stream = opendir(directory.c_str());
+  if (!stream)
+    error("Failed to open directory");
+
+  while (const dirent* entry = readdir(stream))
+  {
+    struct stat info;
+    const wire::string path = directory + "/" + entry->d_name;
+    const bool is_directory = stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+    entries.push_back(std::make_pair(wire::string(entry->d_name), is_directory));
+  }
+
+  closedir(stream);
+#endif
+
+  // Sort the entries so the order of the paths doesn't depend on the system
+  std::sort(entries.begin(), entries.end());
+
+  for (const auto& entry : entries)
+  {
+    if (entry.first.empty() || entry.first[0] == '.')
+      continue;
+
+    const wire::string path = directory + "/" + entry.first;
+
+    if (entry.second)
+      find_sources(path, paths);
+    else
+    {
+      for (size_t i = 0;  suffixes[i];  i++)
+      {
+        if (entry.first.ends_with(suffixes[i]))
+        {
+          paths.push_back(path);
+          break;
+        }
+      }
+    }
+  }
+}
+
+// Returns the identifiers of the GL and window system APIs and their PFN
+// typedefs in the sources in the specified directory, in sorted order
+// Identifiers in comments and strings are included, which at worst keeps
+// an unused command or enum
+//
+std::set<std::string> scan_sources(const wire::string& directory)
+{
+  static const char* prefixes[] =
+  {
+    "gl", "GL", "egl", "EGL", "wgl", "WGL", "PFN", NULL
+  };
+
+  std::set<std::string> names;
+  std::vector<wire::string> paths;
+  find_sources(directory, paths);
+
+  for (const wire::string& path : paths)
+  {
+    const wire::string text = read_file(path.c_str());
+    const char* c = text.c_str();
+
+    while (*c)
+    {
+      if (!std::isalpha((unsigned char) *c) && *c != '_')
+      {
+        // Skip numbers as a whole, so suffixes like 0x1gl aren't identifiers
+        if (std::isdigit((unsigned char) *c))
+        {
+          while (std::isalnum((unsigned char) *c) || *c == '_')
+            c++;
+        }
+        else
+          c++;
+
+        continue;
+      }
+
+      const char* start = c;
+      while (std::isalnum((unsigned char) *c) || *c == '_')
+        c++;
+
+      for (size_t i = 0;  prefixes[i];  i++)
+      {
+        if (std::strncmp(start, prefixes[i], std::strlen(prefixes[i])) == 0)
+        {
+          names.insert(std::string(start, c));
+          break;
+        }
+      }
+    }
+  }
+
+  return names;
+}
+
+// Removes the commands and enums not among the specified identifiers from
+// the specified manifest, except for those used by the loader itself
+// Commands are also kept if their PFN...PROC typedef is used, and types
+// named directly are added so they survive the dependency pass
+// All types other than function pointers are kept, as the platform headers
+// included by the loader may use any of them
+//
+void prune_manifest(Manifest& manifest,
+                    const Target& target,
+                    const Registry& registry,
+                    const std::set<std::string>& names)
+{
+  static const char* gl_names[] =
+  {
+    "glGetString", "glGetStringi", "glGetIntegerv",
+    "GL_VERSION", "GL_EXTENSIONS", "GL_NUM_EXTENSIONS",
+    "GL_TRUE", "GL_FALSE", "GL_MAJOR_VERSION", "GL_MINOR_VERSION", "GLboolean", NULL
+  };
+
+  static const char* egl_names[] =
+  {
+    "eglGetProcAddress", "eglQueryString", "EGL_VERSION", "EGL_EXTENSIONS",
+    "EGLDisplay", "EGLint", NULL
+  };
+
+  static const char* glx_names[] =
+  {
+    "glXGetProcAddressARB", "glXQueryVersion", "glXQueryExtensionsString", NULL
+  };
+
+  static const char* wgl_names[] =
+  {
+    "wglGetProcAddress", "wglGetExtensionsStringARB", "wglGetExtensionsStringEXT", NULL
+  };
+
+  const char** loader_names = gl_names;
+  if (target.api == "egl")
+    loader_names = egl_names;
+  else if (target.api == "glx")
+    loader_names = glx_names;
+  else if (target.api == "wgl")
+    loader_names = wgl_names;
+
+  Bitset commands(registry.command_symbols.size());
+  Bitset enums(registry.enum_symbols.size());
+  std::vector<std::string> used(names.begin(), names.end());
+
+  for (size_t i = 0;  loader_names[i];  i++)
+    used.push_back(loader_names[i]);
+
+  for (const std::string& name : used)
+  {
+    const Symbol command = registry.command_symbols.find(name.c_str());
+    if (command != no_symbol)
+      commands.set(command);
+
+    const Symbol e = registry.enum_symbols.find(name.c_str());
+    if (e != no_symbol)
+      enums.set(e);
+
+    const Symbol type = registry.type_symbols.find(name.c_str());
+    if (type != no_symbol)
+      manifest.types.set(type);
+  }
+
+  for (const CommandSpec& cs : registry.commands)
+  {
+    std::string name = "PFN";
+    for (const char* c = cs.name;  *c;  c++)
+      name += (char) std::toupper((unsigned char) *c);
+    name += "PROC";
+
+    if (names.count(name))
+      commands.set(cs.symbol);
+  }
+
+  for (const TypeSpec& ts : registry.types)
+  {
+    if (!std::strchr(ts.text, '('))
+      manifest.types.set(ts.symbol);
+  }
+
+  manifest.commands &= commands;
+  manifest.enums &= enums;
+}
+
+// Returns whether the specified type definition is the one used by the
+// specified target, as a definition for its API replaces any without one
+// The manifest must already know which types have a definition for the API
+//
+bool type_applies(const Manifest& manifest, const Target& target, const TypeSpec& ts)
+{
+  if (*ts.api == '\0')
+    return !manifest.api_types.test(ts.symbol);
+
+  return ts.api == target.api;
+}
+
+// Generates a manifest from the specified registry according to the
+// specified target
+//
+Manifest generate_manifest(const Target& target, const Registry& registry)
+{
+  Manifest manifest;
+  manifest.types = Bitset(registry.type_symbols.size());
+  manifest.api_types = Bitset(registry.type_symbols.size());
+  manifest.commands = Bitset(registry.command_symbols.size());
+  manifest.enums = Bitset(registry.enum_symbols.size());
+  manifest.command_owners.resize(registry.command_symbols.size());
+  manifest.enum_owners.resize(registry.enum_symbols.size());
+
+  for (const FeatureSpec& fs : registry.features)
+  {
+    if (fs.api == target.api && fs.version <= target.version)
+    {
+      update_manifest(manifest, target, fs);
+
+      const Feature feature = { fs.name, fs.version };
+      manifest.features.push_back(feature);
+    }
+  }
+
+  for (const ExtensionSpec& es : registry.extensions)
+  {
+    if (target.extensions.count(es.name))
+    {
+      const wire::string n = target.api + target.profile;
+      const wire::strings p = wire::string(es.supported).split("|");
+
+      if (std::find(p.begin(), p.end(), n) == p.end())
+      {
+        std::printf("Excluding unsupported extension %s\n", es.name);
+        continue;
+      }
+
+      update_manifest(manifest, target, es);
+      manifest.extensions.push_back(es.name);
+    }
+  }
+
+  if (!target.scan_path.empty())
+    prune_manifest(manifest, target, registry, scan_sources(target.scan_path));
+
+  for (const CommandSpec& cs : registry.commands)
+  {
+    if (!manifest.commands.test(cs.symbol))
+      continue;
+
+    for (const Symbol type : cs.param_types)
+      manifest.types.set(type);
+  }
+
+  for (const TypeSpec& ts : registry.types)
+  {
+    if (ts.api == target.api)
+      manifest.api_types.set(ts.symbol);
+  }
+
+  // Types are listed after those they depend on, so walking them backwards
+  // follows chains of dependencies, as with eglplatform and khrplatform
+  // Types named in the text of a type are dependencies as well, as the
+  // registry doesn't always say so, as with GLchar in GLDEBUGPROC
+  std::string name;
+  for (auto ts = registry.types.rbegin();  ts != registry.types.rend();  ts++)
+  {
+    if (!manifest.types.test(ts->symbol) || !type_applies(manifest, target, *ts))
+      continue;
+
+    if (ts->dependency != no_symbol)
+      manifest.types.set(ts->dependency);
+
+    for (const char* c = ts->text;  *c;  )
+    {
+      if (!std::isalpha((unsigned char) *c) && *c != '_')
+      {
+        c++;
+        continue;
+      }
+
+      const char* start = c;
+      while (std::isalnum((unsigned char) *c) || *c == '_')
+        c++;
+
+      name.assign(start, c);
+      const Symbol type = registry.type_symbols.find(name.c_str());
+      if (type != no_symbol)
+        manifest.types.set(type);
+    }
+  }
+
+  return manifest;
+}
+
+// Checks whether the specified return type text is void
+//
+bool returns_void(const char* proto)
+{
+  wire::string type = proto;
+  while (!type.empty() && type[type.size() - 1] == ' ')
+    type.resize(type.size() - 1);
+
+  return type == "void";
+}
+
+// Returns the call counts of the usage profile at the specified path
+// Each non-empty line not starting with # holds a command name and the
+// number of calls to it, as printed from the results of gregGetProfile
+//
+std::unordered_map<std::string, uint64_t> read_usage(const char* path)
+{
+  std::unordered_map<std::string, uint64_t> usage;
+  std::istringstream lines(read_file(path));
+  std::string line;
+
+  while (std::getline(lines, line))
+  {
+    std::istringstream words(line);
+    std::string name;
+    uint64_t calls;
+
+    if (!(words >> name) || name[0] == '#')
+      continue;
+
+    if (!(words >> calls))
+      error("Invalid line in usage profile");
+
+    usage[name] += calls;
+  }
+
+  return usage;
+}
+
+// Returns the command at the end of the alias chain of the specified command
+// The number of steps is bounded in case the registry has alias cycles
+//
+Symbol alias_root(const std::vector<Symbol>& aliases, Symbol symbol)
+{
+  for (size_t i = 0;  i < aliases.size() && aliases[symbol] != no_symbol;  i++)
+    symbol = aliases[symbol];
+
+  return symbol;
+}
+
+// Returns the module output of the specified owner, or NULL if the target
+// is not modular
+//
+ModuleOutput* module_output(Output& output, Owner owner)
+{
+  if (owner >= output.module_outputs.size())
+    return NULL;
+
+  return &output.module_outputs[owner];
+}
+
+// Writes the text of an item to the specified buffer of the output, or of the
+// module of each of its owners if the target is modular
+// Items in several modules are guarded by the specified macro, if not NULL, so
+// that any number of those modules can be included, and the guard is defined
+// along with the item unless the item itself defines it
+//
+void write_owned(Output& output, Buffer Output::* buffer,
+                 Buffer ModuleOutput::* module_buffer, const Owners& owners,
+                 const Buffer& text, const char* guard, bool define_guard)
+{
+  if (output.module_outputs.empty())
+  {
+    output.*buffer << text.str();
+    return;
+  }
+
+  for (const Owner owner : owners)
+  {
+    Buffer& target = output.module_outputs[owner].*module_buffer;
+
+    if (owners.size() < 2 || !guard)
+    {
+      target << text.str();
+      continue;
+    }
+
+    target << "#ifndef " << guard << '\n';
+    if (define_guard)
+      target << "#define " << guard << '\n';
+
+    target << text.str() << "#endif\n";
+  }
+}
+
+// The largest string literal MSVC accepts, including its terminator
+//
+const size_t max_string_literal = 65535;
+
+// Appends a C array of the specified names, each followed by a null, to the
+// specified buffer
+// The names are written as a string literal unless that is too large for
+// MSVC, in which case they are written as characters instead
+//
+void write_names(Buffer& output, const char* name, const std::vector<const char*>& names)
+{
+  size_t size = 1;
+  for (const char* n : names)
+    size += std::strlen(n) + 1;
+
+  output << "static const char " << name << "[] =";
+
+  if (size <= max_string_literal)
+  {
+    for (const char* n : names)
+      output << "\n    \"" << n << "\\0\"";
+
+    output << ";\n";
+    return;
+  }
+
+  output << "\n{";
+
+  for (const char* n : names)
+  {
+    output << "\n    ";
+
+    for (const char* c = n;  *c;  c++)
+      output << '\'' << *c << "',";
+
+    output << "0,";
+  }
+
+  output << "\n    0\n};\n";
+}
+
+// Appends a C array of the specified unsigned values to the specified buffer
+// The element type is the smallest of unsigned short and unsigned long that
+// holds every value
+//
+void write_array(Buffer& output, const char* name, const std::vector<uint32_t>& values)
+{
+  const bool wide = !values.empty() &&
+                    *std::max_element(values.begin(), values.end()) > 0xffff;
+
+  output << "static const " << (wide ? "unsigned long " : "unsigned short ")
+         << name << "[] =\n{\n";
+
+  for (size_t i = 0;  i < values.size();  i++)
+  {
+    output << (i % 10 ? " " : "    ") << (unsigned int) values[i] << ',';
+    if (i % 10 == 9 || i + 1 == values.size())
+      output << '\n';
+  }
+
+  output << "};\n";
+}
+
+// The basis of the bucket hash of names, which is the 32-bit FNV-1a basis
+//
+const uint32_t name_basis = 2166136261u;
+
+// Returns the 32-bit FNV-1a hash of the specified name, starting from the
+// specified basis, followed by the MurmurHash3 finalizer
+// Without the finalizer the low bits, and with them the slots of small
+// tables, would depend on too few bits of the name
+// This must match gregHashString in the implementation template
+//
+uint32_t hash_name(const char* name, uint32_t hash)
+{
+  for (;  *name;  name++)
+  {
+    hash ^= (unsigned char) *name;
+    hash *= 16777619u;
+  }
+
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+
+  return hash;
+}
+
+// A minimal perfect hash of a set of names, built by hash and displace
+// Each name is hashed with the name basis into one of as many buckets as
+// there are names, and then with the seed of its bucket into its slot
+//
+struct PerfectHash
+{
+  std::vector<uint32_t> seeds;
+  std::vector<uint32_t> slots;
+};
+
+// Builds a minimal perfect hash of the specified names
+// Buckets are placed largest first, each with the first seed that moves all
+// of its names into distinct free slots
+//
+PerfectHash perfect_hash(const std::vector<wire::string>& names)
+{
+  const uint32_t count = names.size();
+
+  PerfectHash result;
+  result.seeds.resize(count, 0);
+  result.slots.resize(count, 0);
+
+  std::vector<std::vector<uint32_t>> buckets(count);
+  for (uint32_t i = 0;  i < count;  i++)
+    buckets[hash_name(names[i].c_str(), name_basis) % count].push_back(i);
+
+  std::vector<uint32_t> order;
+  for (uint32_t i = 0;  i < count;  i++)
+    order.push_back(i);
+
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+  {
+    return buckets[a].size() > buckets[b].size();
+  });
+
+  std::vector<bool> used(count, false);
+  std::vector<uint32_t> slots;
+
+  for (const uint32_t bucket : order)
+  {
+    if (buckets[bucket].empty())
+      break;
+
+    for (uint32_t seed = 1;  ;  seed++)
+    {
+      if (seed == 0)
+        error("Failed to generate extension hash");
+
+      slots.clear();
+
+      for (const uint32_t name : buckets[bucket])
+      {
+        const uint32_t slot = hash_name(names[name].c_str(), seed) % count;
+        if (used[slot] || std::find(slots.begin(), slots.end(), slot) != slots.end())
+          break;
+
+        slots.push_back(slot);
+      }
+
+      if (slots.size() < buckets[bucket].size())
+        continue;
+
+      for (size_t i = 0;  i < slots.size();  i++)
+      {
+        used[slots[i]] = true;
+        result.slots[buckets[bucket][i]] = slots[i];
+      }
+
+      result.seeds[bucket] = seed;
+      break;
+    }
+  }
+
+  return result;
+}
+
+// Writes the profiling wrapper of the specified command, which adds the
+// time spent in the command to its profile
+//
+void write_profiler(Output& output, const CommandSpec& cs, uint32_t index)
+{
+  const Uppercase typedef_name = { cs.name };
+  const bool is_void = returns_void(cs.proto);
+  const char last = cs.proto[std::strlen(cs.proto) - 1];
+  const char* result = last == ' ' || last == '*' ? "result = " : " result = ";
+
+  output.cmd_profilers << "static " << cs.proto << " GLAPIENTRY gregProfile_" << cs.name
+                       << "(" << cs.named_params << ")\n{\n"
+                       << "    const double start = gregGetTime();\n    "
+                       << (is_void ? "" : cs.proto) << (is_void ? "" : result)
+                       << "((PFN" << typedef_name << "PROC) GREG_PROCS[" << (unsigned int) index << "])(";
+
+  for (unsigned int i = 0;  i < cs.param_count;  i++)
+    output.cmd_profilers << (i ? ", p" : "p") << i;
+
+  output.cmd_profilers << ");\n    gregProfileCall(" << (unsigned int) index << ", start);\n"
+                       << (is_void ? "" : "    return result;\n") << "}\n\n";
+}
+
+// Writes the tracing wrapper of the specified command, which records the
+// command and the values of its parameters before calling it, through the
+// profiling wrapper if there is one
+//
+void write_tracer(Output& output, const CommandSpec& cs, uint32_t index, bool profiling)
+{
+  const Uppercase typedef_name = { cs.name };
+  Buffer& tracers = output.cmd_tracers;
+
+  tracers << "static " << cs.proto << " GLAPIENTRY gregTrace_" << cs.name
+          << "(" << cs.named_params << ")\n{\n";
+
+  if (cs.param_count)
+  {
+    tracers << "    if (greg_trace.data)\n    {\n        unsigned char args[";
+
+    for (unsigned int i = 0;  i < cs.param_count;  i++)
+      tracers << (i ? " + sizeof(p" : "sizeof(p") << i << ')';
+
+    tracers << "], *a = args;\n\n";
+
+    for (unsigned int i = 0;  i < cs.param_count;  i++)
+    {
+      tracers << "        memcpy(a, &p" << i << ", sizeof(p" << i << "));";
+      if (i + 1 < cs.param_count)
+        tracers << "  a += sizeof(p" << i << ");";
+      tracers << "\n";
+    }
+
+    tracers << "        gregTraceCall(" << (unsigned int) index
+            << ", args, sizeof(args));\n    }\n\n";
+  }
+  else
+    tracers << "    if (greg_trace.data)\n        gregTraceCall("
+            << (unsigned int) index << ", NULL, 0);\n\n";
+
+  tracers << "    " << (returns_void(cs.proto) ? "" : "return ") << "((PFN" << typedef_name
+          << "PROC) " << (profiling ? "greg_profilers[" : "GREG_PROCS[")
+          << (unsigned int) index << "])(";
+
+  for (unsigned int i = 0;  i < cs.param_count;  i++)
+    tracers << (i ? ", p" : "p") << i;
+
+  tracers << ");\n}\n\n";
+}
+
+// Writes a table of the wrappers with the specified prefix, at the same
+// indices as their commands
+//
+void write_wrapper_table(Buffer& buffer,
+                         const char* name,
+                         const char* prefix,
+                         const std::vector<const CommandSpec*>& commands)
+{
+  buffer << "GREGDEF const GREGproc " << name << "["
+         << (unsigned int) commands.size() << "] =\n{";
+
+  for (const CommandSpec* cs : commands)
+    buffer << "\n    (GREGproc) " << prefix << cs->name << ',';
+
+  buffer << "\n};\n";
+}
+
+// Returns whether the specified API is that of a window system registry
+//
+bool is_window_system_api(const wire::string& api)
+{
+  return api == "egl" || api == "glx" || api == "wgl";
+}
+
+// Returns the identifier prefixes of the loader for the specified API
+//
+Naming api_naming(const wire::string& api)
+{
+  if (api == "egl")
+    return Naming { "gregEGL", "GREG_EGL", "EGL_" };
+  else if (api == "glx")
+    return Naming { "gregGLX", "GREG_GLX", "GLX_" };
+  else if (api == "wgl")
+    return Naming { "gregWGL", "GREG_WGL", "WGL_" };
+  else
+    return Naming { "greg", "GREG", "GL_" };
+}
+
+// Generates output strings from the specified registry according to the
+// specified manifest and target
+//
+Output generate_output(const Manifest& manifest,
+                       const Target& target,
+                       const Registry& registry)
+{
+  Output output;
+  const Naming naming = api_naming(target.api);
+  const wire::string lower = naming.lower;
+  const wire::string upper = naming.upper;
+
+  output.prefix << naming.lower;
+  output.prefix_upper << naming.upper;
+
+  if (target.api == "egl")
+    output.egl << "1";
+  else if (target.api == "glx")
+    output.glx << "1";
+  else if (target.api == "wgl")
+    output.wgl << "1";
+
+  if (target.split)
+    output.split << "1";
+
+  if (target.profiling)
+    output.profiling << "1";
+
+  if (target.tracing)
+    output.tracing << "1";
+
+  if (target.profiling || target.tracing)
+    output.timing << "1";
+
+  if (target.direct_version.major)
+    output.direct << "1";
+
+  output.header_name << file_name(target.output_path);
+
+  if (target.modular)
+    output.types_header << "greg/" << file_name(types_path(target));
+  else if (target.types_header)
+    output.types_header << file_name(types_path(target));
+
+  if (target.api == "gl")
+    output.api_name << "OpenGL";
+  else if (target.api == "gles1" || target.api == "gles2")
+    output.api_name << "OpenGL ES";
+  else if (target.api == "egl")
+    output.api_name << "EGL";
+  else if (target.api == "glx")
+    output.api_name << "GLX";
+  else if (target.api == "wgl")
+    output.api_name << "WGL";
+
+  // Reserve roughly the expected size of each section up front
+  const size_t extension_count = manifest.extensions.size();
+  output.ext_macros.reserve(extension_count * 48);
+  output.ext_declarations.reserve(extension_count * 48);
+  output.ext_names.reserve(extension_count * 64 + 128);
+
+  const size_t feature_count = manifest.features.size();
+  output.ver_macros.reserve(feature_count * 32);
+  output.ver_declarations.reserve(feature_count * 32);
+  output.ver_loaders.reserve(feature_count * 64);
+
+  output.type_typedefs.reserve(manifest.types.count() * 64);
+  output.enum_definitions.reserve(manifest.enums.count() * 64);
+
+  const size_t command_count = manifest.commands.count();
+  output.cmd_typedefs.reserve(command_count * 112);
+  output.cmd_macros.reserve(command_count * 64);
+  output.cmd_names.reserve(command_count * 40);
+  output.cmd_trampolines.reserve(command_count * 200);
+  output.cmd_trampoline_table.reserve(command_count * 40 + 64);
+  output.cmd_groups.reserve((feature_count + extension_count) * 48 + 128);
+
+  // Modular targets put the macros and declarations of each feature and
+  // extension in that module instead, and include all modules in the header
+  if (target.modular)
+  {
+    output.module_types_header << file_name(types_path(target));
+    output.module_outputs.resize(feature_count + extension_count);
+
+    for (size_t i = 0;  i < feature_count;  i++)
+      output.module_outputs[i].name << manifest.features[i].name;
+
+    for (size_t i = 0;  i < extension_count;  i++)
+      output.module_outputs[feature_count + i].name << manifest.extensions[i];
+
+    for (const ModuleOutput& module : output.module_outputs)
+      output.modules << "#include \"greg/" << module.name.str() << ".h\"\n";
+  }
+
+  for (size_t i = 0;  i < extension_count;  i++)
+  {
+    const wire::string& extension = manifest.extensions[i];
+    const BooleanName boolean_name = { naming, extension.c_str() };
+    ModuleOutput* module = module_output(output, feature_count + i);
+    Buffer& macros = module ? module->macro : output.ext_macros;
+    Buffer& declarations = module ? module->declaration : output.ext_declarations;
+
+    macros << "#define " << extension << " 1\n";
+    declarations << "#define " << boolean_name << ' ' << naming.upper << "_BOOLEANS["
+                 << (unsigned int) (feature_count + i) << "]\n";
+    declarations << "#define " << boolean_name << "_INDEX "
+                 << (unsigned int) (feature_count + i) << "\n";
+  }
+
+  // Extension names and boolean indices are listed in the slot order of a perfect
+  // hash of the names, so detection can find each extension of the context
+  // with a single hash and compare
+  output.ext_names << "#define " << naming.upper << "_EXTENSION_COUNT "
+                   << (unsigned int) extension_count << "\n";
+
+  if (extension_count)
+  {
+    const PerfectHash hash = perfect_hash(manifest.extensions);
+
+    std::vector<uint32_t> extensions(extension_count);
+    for (size_t i = 0;  i < extension_count;  i++)
+      extensions[hash.slots[i]] = i;
+
+    std::vector<uint32_t> offsets;
+    uint32_t names_size = 0;
+
+    std::vector<const char*> names;
+    for (const uint32_t i : extensions)
+    {
+      names.push_back(manifest.extensions[i].c_str());
+      offsets.push_back(names_size);
+      names_size += manifest.extensions[i].size() + 1;
+    }
+
+    output.ext_names << '\n';
+    write_names(output.ext_names, (lower + "_extension_names").c_str(), names);
+    output.ext_names << '\n';
+    write_array(output.ext_names, (lower + "_extension_offsets").c_str(), offsets);
+    output.ext_names << '\n';
+    write_array(output.ext_names, (lower + "_extension_seeds").c_str(), hash.seeds);
+
+    std::vector<uint32_t> booleans;
+    for (const uint32_t i : extensions)
+      booleans.push_back(feature_count + i);
+
+    output.ext_names << '\n';
+    write_array(output.ext_names, (lower + "_extension_booleans").c_str(), booleans);
+  }
+
+  for (size_t i = 0;  i < feature_count;  i++)
+  {
+    const Feature& feature = manifest.features[i];
+    const BooleanName boolean_name = { naming, feature.name.c_str() };
+    ModuleOutput* module = module_output(output, i);
+    Buffer& macros = module ? module->macro : output.ver_macros;
+    Buffer& declarations = module ? module->declaration : output.ver_declarations;
+
+    macros << "#define " << feature.name << " 1\n";
+    declarations << "#define " << boolean_name << ' ' << naming.upper << "_BOOLEANS["
+                 << (unsigned int) i << "]\n";
+    declarations << "#define " << boolean_name << "_INDEX " << (unsigned int) i << "\n";
+    output.ver_loaders << "    " << boolean_name << " = " << naming.lower
+                       << "VersionSupported(" << feature.version.major
+                       << ", " << feature.version.minor << ");\n";
+  }
+
+  for (const TypeSpec& ts : registry.types)
+  {
+    if (!manifest.types.test(ts.symbol) || !type_applies(manifest, target, ts))
+      continue;
+
+    output.type_typedefs << ts.text << '\n';
+    output.type_count++;
+  }
+
+  for (const EnumSpec& es : registry.enums)
+  {
+    if (!manifest.enums.test(es.symbol))
+      continue;
+
+    Buffer definition;
+    definition << "#define " << es.name << ' ' << es.value << '\n';
+    write_owned(output, &Output::enum_definitions, &ModuleOutput::enum_definitions,
+                manifest.enum_owners[es.symbol], definition, es.name, false);
+
+    output.enum_count++;
+  }
+
+  // Function pointers live in a single table, loaded in loops from a blob
+  // of NUL-separated names and an array of offsets into it
+  // The table is ordered by owner, so the commands of each feature and
+  // extension form a range that is loaded only if it is supported
+  // Commands that are aliases of each other share a single entry, loaded by
+  // trying each of their names in turn
+  // Entries with several owners, as aliases or as commands required by
+  // several features and extensions, follow those ranges and are loaded if
+  // any of their owners is supported
+  // Commands of the versions linked directly are left out of the table
+  std::vector<Symbol> aliases(registry.command_symbols.size(), no_symbol);
+  for (const CommandSpec& cs : registry.commands)
+    aliases[cs.symbol] = cs.alias;
+
+  const auto is_direct = [&](const CommandSpec& cs)
+  {
+    const Owner owner = manifest.command_owners[cs.symbol].front();
+    return target.direct_version.major && owner < feature_count &&
+           manifest.features[owner].version <= target.direct_version;
+  };
+
+  std::vector<std::vector<const CommandSpec*>> entries;
+  std::vector<uint32_t> root_entries(registry.command_symbols.size(), ~0u);
+  entries.reserve(command_count);
+
+  for (const CommandSpec& cs : registry.commands)
+  {
+    if (!manifest.commands.test(cs.symbol) || is_direct(cs))
+      continue;
+
+    const Symbol root = alias_root(aliases, cs.symbol);
+    if (root_entries[root] == ~0u)
+    {
+      root_entries[root] = entries.size();
+      entries.push_back(std::vector<const CommandSpec*>());
+    }
+
+    // The promoted command is tried first and the others in registry order
+    std::vector<const CommandSpec*>& entry = entries[root_entries[root]];
+    if (cs.symbol == root)
+      entry.insert(entry.begin(), &cs);
+    else
+      entry.push_back(&cs);
+  }
+
+  const auto entry_owner = [&](const std::vector<const CommandSpec*>& entry)
+  {
+    Owner owner = no_owner;
+    for (const CommandSpec* cs : entry)
+      owner = std::min(owner, manifest.command_owners[cs->symbol].front());
+
+    return owner;
+  };
+
+  // Each version supports all earlier ones, so only the lowest version and
+  // the extensions requiring the commands of an entry decide its loading
+  const auto load_owners = [&](const std::vector<const CommandSpec*>& entry)
+  {
+    std::set<Owner> owners;
+    Owner version = no_owner;
+
+    for (const CommandSpec* cs : entry)
+    {
+      for (const Owner owner : manifest.command_owners[cs->symbol])
+      {
+        if (owner < feature_count)
+          version = std::min(version, owner);
+        else
+          owners.insert(owner);
+      }
+    }
+
+    if (version != no_owner)
+      owners.insert(version);
+
+    return owners;
+  };
+
+  // The lowest version is always loaded first, as checking versions and
+  // extensions needs its commands, so its entries stay in its range
+  Bitset shared(registry.command_symbols.size());
+  for (const std::vector<const CommandSpec*>& entry : entries)
+  {
+    const std::set<Owner> owners = load_owners(entry);
+    if (owners.size() > 1 && *owners.begin() != 0)
+      shared.set(entry[0]->symbol);
+  }
+
+  const auto is_shared = [&](const std::vector<const CommandSpec*>& entry)
+  {
+    return shared.test(entry[0]->symbol);
+  };
+
+  std::stable_sort(entries.begin(), entries.end(),
+                   [&](const std::vector<const CommandSpec*>& a,
+                       const std::vector<const CommandSpec*>& b)
+  {
+    if (is_shared(a) != is_shared(b))
+      return is_shared(b);
+
+    return entry_owner(a) < entry_owner(b);
+  });
+
+  // With a usage profile the table is instead ordered by descending number
+  // of calls, so the most used commands share cache lines, and the loader
+  // maps each position in load order to its entry in the table
+  std::vector<uint32_t> table(entries.size()), slots(entries.size());
+  for (uint32_t position = 0;  position < entries.size();  position++)
+    table[position] = position;
+
+  if (!target.usage_path.empty())
+  {
+    const auto usage = read_usage(target.usage_path.c_str());
+    std::vector<uint64_t> calls(entries.size(), 0);
+
+    for (size_t position = 0;  position < entries.size();  position++)
+    {
+      for (const CommandSpec* cs : entries[position])
+      {
+        const auto entry = usage.find(cs->name);
+        if (entry != usage.end())
+          calls[position] += entry->second;
+      }
+    }
+
+    std::stable_sort(table.begin(), table.end(), [&](uint32_t a, uint32_t b)
+    {
+      return calls[a] > calls[b];
+    });
+  }
+
+  Buffer trampolines;
+  std::vector<const char*> names;
+  std::vector<const CommandSpec*> commands;
+  std::vector<uint32_t> offsets, group_ends(feature_count + extension_count, 0);
+  std::vector<uint32_t> alias_owners, alias_owner_ends;
+  std::vector<uint32_t> indices(registry.command_symbols.size(), 0);
+  uint32_t names_size = 0, trace_max_args = 0;
+
+  names.reserve(command_count);
+  trampolines.reserve(command_count * 40);
+  commands.reserve(entries.size());
+  offsets.reserve(entries.size() + 1);
+
+  for (uint32_t position = 0;  position < entries.size();  position++)
+  {
+    const std::vector<const CommandSpec*>& entry = entries[position];
+
+    // Shared entries are loaded if any of their owners are supported
+    if (is_shared(entry))
+    {
+      const std::set<Owner> owners = load_owners(entry);
+      alias_owners.insert(alias_owners.end(), owners.begin(), owners.end());
+      alias_owner_ends.push_back(alias_owners.size());
+    }
+    else
+      group_ends[entry_owner(entry)] = position + 1;
+  }
+
+  for (uint32_t index = 0;  index < entries.size();  index++)
+  {
+    const std::vector<const CommandSpec*>& entry = entries[table[index]];
+    const CommandSpec& cs = *entry[0];
+    const Uppercase typedef_name = { cs.name };
+
+    slots[table[index]] = index;
+    commands.push_back(&cs);
+    offsets.push_back(names_size);
+
+    for (const CommandSpec* alias : entry)
+    {
+      indices[alias->symbol] = index;
+      names.push_back(alias->name);
+      names_size += std::strlen(alias->name) + 1;
+    }
+
+    // The lazy binding trampoline resolves the command, after which the
+    // table entry points to the command itself
+    output.cmd_trampolines << "static " << cs.proto << " GLAPIENTRY " << naming.lower
+                           << "Lazy_" << cs.name << "(" << cs.named_params << ")\n{\n    "
+                           << (returns_void(cs.proto) ? "" : "return ")
+                           << "((PFN" << typedef_name << "PROC) " << naming.lower
+                           << "ResolveCommand("
+                           << index << "))(";
+
+    for (unsigned int i = 0;  i < cs.param_count;  i++)
+      output.cmd_trampolines << (i ? ", p" : "p") << i;
+
+    output.cmd_trampolines << ");\n}\n\n";
+    trampolines << "\n    (GREGproc) " << naming.lower << "Lazy_" << cs.name << ',';
+  }
+
+  // Groups without commands end where the previous group ended
+  for (size_t i = 1;  i < group_ends.size();  i++)
+    group_ends[i] = std::max(group_ends[i], group_ends[i - 1]);
+
+  for (const CommandSpec& cs : registry.commands)
+  {
+    if (!manifest.commands.test(cs.symbol))
+      continue;
+
+    const Uppercase typedef_name = { cs.name };
+    const Owners& owners = manifest.command_owners[cs.symbol];
+    Buffer typedef_text, macro_text;
+    output.command_count++;
+
+    // Typedefs cannot be repeated, so shared ones get a guard of their own
+    Buffer typedef_guard;
+    typedef_guard << naming.upper << "_PFN" << typedef_name << "PROC";
+    typedef_text << "typedef " << cs.proto
+                 << " (GLAPIENTRY *PFN" << typedef_name << "PROC)("
+                 << cs.params << ");\n";
+    write_owned(output, &Output::cmd_typedefs, &ModuleOutput::cmd_typedefs,
+                owners, typedef_text, typedef_guard.str().c_str(), true);
+
+    // Declarations of directly linked commands may be repeated
+    if (is_direct(cs))
+    {
+      macro_text << "GREGAPI " << cs.proto << " GLAPIENTRY " << cs.name
+                 << "(" << cs.params << ");\n";
+      write_owned(output, &Output::cmd_macros, &ModuleOutput::cmd_macros,
+                  owners, macro_text, NULL, false);
+      continue;
+    }
+
+    // Entries shared by aliases are wrapped once, for their first command
+    if (commands[indices[cs.symbol]] == &cs)
+    {
+      if (target.profiling)
+        write_profiler(output, cs, indices[cs.symbol]);
+
+      if (target.tracing)
+      {
+        write_tracer(output, cs, indices[cs.symbol], target.profiling);
+        trace_max_args = std::max(trace_max_args, cs.param_count);
+      }
+    }
+
+    // Wrapped commands are called through the table of the outermost
+    // wrappers, and are still NULL when not loaded
+    if (target.profiling || target.tracing)
+    {
+      macro_text << "#define " << cs.name << " ((PFN" << typedef_name << "PROC) (GREG_PROCS["
+                 << (unsigned int) indices[cs.symbol] << "] ? "
+                 << (target.tracing ? "greg_tracers[" : "greg_profilers[")
+                 << (unsigned int) indices[cs.symbol] << "] : 0))\n";
+    }
+    else
+    {
+      macro_text << "#define " << cs.name << " ((PFN" << typedef_name << "PROC) "
+                 << naming.upper << "_PROCS[" << (unsigned int) indices[cs.symbol] << "])\n";
+    }
+
+    write_owned(output, &Output::cmd_macros, &ModuleOutput::cmd_macros,
+                owners, macro_text, cs.name, false);
+  }
+
+  output.group_count << (unsigned int) group_ends.size();
+  output.table_size << (unsigned int) commands.size();
+  output.cmd_trampoline_table << "static const GREGproc " << naming.lower << "_trampolines["
+                              << (unsigned int) commands.size() << "] =\n{"
+                              << trampolines.str() << "\n};\n";
+  write_names(output.cmd_names, (lower + "_names").c_str(), names);
+  output.cmd_names << '\n';
+
+  if (target.profiling)
+    write_wrapper_table(output.cmd_profilers, "greg_profilers", "gregProfile_", commands);
+
+  if (target.tracing)
+  {
+    write_wrapper_table(output.cmd_tracers, "greg_tracers", "gregTrace_", commands);
+    output.trace_max_args << (unsigned int) trace_max_args;
+  }
+
+  // The names of each entry end where those of the next one begin
+  offsets.push_back(names_size);
+  write_array(output.cmd_names, (lower + "_offsets").c_str(), offsets);
+
+  // Each feature and extension is listed by the end of its range in load
+  // order, in owner order
+  output.cmd_groups << "#define " << naming.upper << "_FEATURE_COUNT "
+                    << (unsigned int) feature_count << "\n\n";
+  write_array(output.cmd_groups, (lower + "_group_ends").c_str(), group_ends);
+
+  if (target.usage_path.empty())
+    output.cmd_groups << "\n#define " << naming.upper << "_SLOT(position) (position)\n";
+  else
+  {
+    output.cmd_groups << '\n';
+    write_array(output.cmd_groups, (lower + "_slots").c_str(), slots);
+    output.cmd_groups << "\n#define " << naming.upper << "_SLOT(position) "
+                      << naming.lower << "_slots[position]\n";
+  }
+
+  // Each shared entry is listed by the end of its range of owners
+  output.cmd_groups << "\n#define " << naming.upper << "_ALIAS_COUNT "
+                    << (unsigned int) alias_owner_ends.size() << "\n";
+
+  if (!alias_owner_ends.empty())
+  {
+    output.cmd_groups << '\n';
+    write_array(output.cmd_groups, (lower + "_alias_owners").c_str(), alias_owners);
+    output.cmd_groups << '\n';
+    write_array(output.cmd_groups, (lower + "_alias_owner_ends").c_str(), alias_owner_ends);
+  }
+
+  return output;
+}
+
+// Maps template tag names, without the surrounding @ characters, to the
+// text they are replaced with
+//
+typedef std::map<wire::string, const Buffer*> Tags;
+
+// Returns the standard template tags for the specified output
+//
+Tags output_tags(const Output& output)
+{
+  Tags tags;
+
+  tags["SPLIT"] = &output.split;
+  tags["HEADER_NAME"] = &output.header_name;
+  tags["TYPES_HEADER"] = &output.types_header;
+  tags["API_NAME"] = &output.api_name;
+  tags["GROUP_COUNT"] = &output.group_count;
+  tags["TABLE_SIZE"] = &output.table_size;
+  tags["TYPE_TYPEDEFS"] = &output.type_typedefs;
+  tags["ENUM_DEFINITIONS"] = &output.enum_definitions;
+  tags["EXT_MACROS"] = &output.ext_macros;
+  tags["VER_MACROS"] = &output.ver_macros;
+  tags["EXT_DECLARATIONS"] = &output.ext_declarations;
+  tags["VER_DECLARATIONS"] = &output.ver_declarations;
+  tags["VER_LOADERS"] = &output.ver_loaders;
+  tags["EXT_NAMES"] = &output.ext_names;
+  tags["CMD_TYPEDEFS"] = &output.cmd_typedefs;
+  tags["CMD_MACROS"] = &output.cmd_macros;
+  tags["CMD_NAMES"] = &output.cmd_names;
+  tags["CMD_TRAMPOLINES"] = &output.cmd_trampolines;
+  tags["CMD_TRAMPOLINE_TABLE"] = &output.cmd_trampoline_table;
+  tags["CMD_GROUPS"] = &output.cmd_groups;
+  tags["CMD_PROFILERS"] = &output.cmd_profilers;
+  tags["CMD_TRACERS"] = &output.cmd_tracers;
+  tags["TRACE_MAX_ARGS"] = &output.trace_max_args;
+  tags["PROFILING"] = &output.profiling;
+  tags["TRACING"] = &output.tracing;
+  tags["TIMING"] = &output.timing;
+  tags["DIRECT"] = &output.direct;
+  tags["MODULES"] = &output.modules;
+  tags["PREFIX"] = &output.prefix;
+  tags["PREFIX_UPPER"] = &output.prefix_upper;
+  tags["EGL"] = &output.egl;
+  tags["GLX"] = &output.glx;
+  tags["WGL"] = &output.wgl;
+
+  return tags;
+}
+
+// Returns the template tags for the sub-header of the specified module
+// These replace the sections of the target with those of the module
+//
+Tags module_tags(const Tags& target_tags,
+                 const Output& output,
+                 const ModuleOutput& module)
+{
+  Tags tags = target_tags;
+
+  tags["MODULE_NAME"] = &module.name;
+  tags["TYPES_HEADER"] = &output.module_types_header;
+  tags["MODULE_MACRO"] = &module.macro;
+  tags["MODULE_DECLARATION"] = &module.declaration;
+  tags["ENUM_DEFINITIONS"] = &module.enum_definitions;
+  tags["CMD_TYPEDEFS"] = &module.cmd_typedefs;
+  tags["CMD_MACROS"] = &module.cmd_macros;
+
+  return tags;
+}
+
+// A template file split once into literal text, @TAG@ tokens and directives
+// A tag name consists of uppercase letters, digits and underscores, so the
+// @ characters of e.g. email addresses are kept as literal text
+// The directives are @INCLUDE FILE@, which expands another template from the
+// same directory, and @IF TAG@ or @IF !TAG@, @ELSE@ and @ENDIF@, which test
+// whether a tag is non-empty
+// A directive alone on a line is removed along with its line
+//
+class Template
+{
+public:
+  explicit Template(const wire::string& path):
+    text(read_file(path.c_str())),
+    hash(hash_data(text.data(), text.size()))
+  {
+    std::vector<size_t> open;
+    size_t start = 0, position = 0;
+
+    while ((position = text.find('@', position)) != wire::string::npos)
+    {
+      size_t end = position + 1;
+      while (end < text.size() &&
+             (std::isupper(text[end]) || std::isdigit(text[end]) || text[end] == '_'))
+      {
+        end++;
+      }
+
+      const wire::string word = text.substr(position + 1, end - position - 1);
+      size_t argument = end, close = end;
+
+      if (end < text.size() && text[end] == ' ' && (word == "IF" || word == "INCLUDE"))
+      {
+        argument = end + 1;
+        close = text.find_first_of("@\n", argument);
+      }
+
+      if (word.empty() || close >= text.size() || text[close] != '@')
+      {
+        position = end;
+        continue;
+      }
+
+      const size_t directive = position;
+      add_token(TEXT, start, directive - start);
+      start = position = close + 1;
+
+      Kind kind = TAG;
+      if (word == "IF")
+        kind = text[argument] == '!' ? IF_NOT : IF;
+      else if (word == "INCLUDE")
+        kind = INCLUDE;
+      else if (word == "ELSE")
+        kind = ELSE;
+      else if (word == "ENDIF")
+        kind = ENDIF;
+
+      if (kind == TAG)
+      {
+        add_token(TAG, directive + 1, word.size());
+        continue;
+      }
+
+      // Remove a directive alone on a line along with its line
+      if ((directive == 0 || text[directive - 1] == '\n') &&
+          start < text.size() && text[start] == '\n')
+      {
+        start = position = start + 1;
+      }
+
+      const size_t name_start = kind == IF_NOT ? argument + 1 : argument;
+      add_token(kind, name_start, close - name_start);
+
+      switch (kind)
+      {
+        case INCLUDE:
+        {
+          const wire::string name = text.substr(name_start, close - name_start);
+          includes.push_back(Template(directory_name(path) + name));
+          tokens.back().jump = includes.size() - 1;
+          hash = hash_data((const char*) &includes.back().hash, sizeof(hash), hash);
+          break;
+        }
+
+        case IF:
+        case IF_NOT:
+          open.push_back(tokens.size() - 1);
+          break;
+
+        case ELSE:
+          if (open.empty() || tokens[open.back()].kind == ELSE)
+            error("Unmatched @ELSE@ in template");
+
+          tokens[open.back()].jump = tokens.size() - 1;
+          open.back() = tokens.size() - 1;
+          break;
+
+        case ENDIF:
+          if (open.empty())
+            error("Unmatched @ENDIF@ in template");
+
+          tokens[open.back()].jump = tokens.size() - 1;
+          open.pop_back();
+          break;
+
+        default:
+          break;
+      }
+    }
+
+    if (!open.empty())
+      error("Unterminated @IF@ in template");
+
+    add_token(TEXT, start, text.size() - start);
+  }
+  // Writes the template to the specified stream, with every known tag
+  // replaced by its text and any unknown tag kept as is
+  void expand(std::ostream& stream, const Tags& tags) const
+  {
+    for (size_t i = 0;  i < tokens.size();  i++)
+    {
+      const Token& token = tokens[i];
+
+      switch (token.kind)
+      {
+        case TEXT:
+          stream.write(text.data() + token.start, token.length);
+          break;
+
+        case TAG:
+        {
+          if (const Buffer* value = find(tags, token))
+          {
+            stream.write(value->str().data(), value->size());
+            break;
+          }
+
+          stream.put('@');
+          stream.write(text.data() + token.start, token.length);
+          stream.put('@');
+          break;
+        }
+
+        case IF:
+        case IF_NOT:
+        {
+          const Buffer* value = find(tags, token);
+          if ((value && !value->empty()) != (token.kind == IF))
+            i = token.jump;
+          break;
+        }
+
+        case ELSE:
+          i = token.jump;
+          break;
+
+        case ENDIF:
+          break;
+
+        case INCLUDE:
+          includes[token.jump].expand(stream, tags);
+          break;
+      }
+    }
+  }
+private:
+  enum Kind { TEXT, TAG, IF, IF_NOT, ELSE, ENDIF, INCLUDE };
+  struct Token
+  {
+    Kind kind;
+    size_t start;
+    size_t length;
+    size_t jump;
+  };
+  void add_token(Kind kind, size_t start, size_t length)
+  {
+    if (length || kind != TEXT)
+    {
+      const Token token = { kind, start, length, 0 };
+      tokens.push_back(token);
+    }
+  }
+  const Buffer* find(const Tags& tags, const Token& token) const
+  {
+    const auto entry = tags.find(text.substr(token.start, token.length));
+    if (entry == tags.end())
+      return NULL;
+
+    return entry->second;
+  }
+  wire::string text;
+  std::vector<Token> tokens;
+  std::vector<Template> includes;
+public:
+  // The hash of the template and of every template it includes
+  uint64_t hash;
+};
+
+// A stream buffer that hashes everything written to it and discards it
+//
+class HashStreamBuf : public std::streambuf
+{
+public:
+  HashStreamBuf(): hash(hash_basis), size(0) { }
+  uint64_t hash;
+  size_t size;
+protected:
+  std::streamsize xsputn(const char* data, std::streamsize count) override
+  {
+    hash = hash_data(data, (size_t) count, hash);
+    size += (size_t) count;
+    return count;
+  }
+  int_type overflow(int_type c) override
+  {
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      const char data = traits_type::to_char_type(c);
+      xsputn(&data, 1);
+    }
+
+    return traits_type::not_eof(c);
+  }
+};
+
+// The size and hash of an expanded template
+//
+struct ContentHash
+{
+  size_t size;
+  uint64_t hash;
+};
+
+// A file generated for a target, with the size and hash of its contents
+//
+struct WrittenFile
+{
+  wire::string path;
+  ContentHash hash;
+};
+
+// Returns the size and hash of the specified template, with any tags
+// replaced by the specified text
+//
+ContentHash hash_content(const Template& content, const Tags& tags)
+{
+  HashStreamBuf hasher;
+  std::ostream hashing(&hasher);
+  content.expand(hashing, tags);
+
+  const ContentHash result = { hasher.size, hasher.hash };
+  return result;
+}
+
+// Writes the specified template to the specified path, with any tags
+// replaced by the specified text
+// An existing file with the specified size and hash is left untouched, so
+// that its modification time does not trigger rebuilds of everything
+// including it
+// Returns false if the file was left untouched
+//
+bool write_content(const char* path,
+                   const Template& content,
+                   const Tags& tags,
+                   const ContentHash& expected)
+{
+  MappedFile existing;
+  if (existing.open(path) && existing.size == expected.size &&
+      hash_data(existing.data, existing.size) == expected.hash)
+  {
+    return false;
+  }
+
+  existing.close();
+
+  std::ofstream stream(path, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (stream.fail())
+    error("Failed to create file");
+
+  content.expand(stream, tags);
+  return true;
+}
+
+// A file generated for a target and the template it is generated from
+//
+struct OutputFile
+{
+  wire::string template_path;
+  wire::string path;
+};
+
+// Returns the files generated for the specified target
+// The templates for the additional files are taken from the directory of
+// the main template
+//
+std::vector<OutputFile> output_files(const Target& target)
+{
+  std::vector<OutputFile> files;
+
+  const OutputFile header = { target.template_path, target.output_path };
+  files.push_back(header);
+
+  const wire::string directory = directory_name(target.template_path);
+
+  if (target.split)
+  {
+    const OutputFile source = { directory + "greg.c.in", source_path(target) };
+    files.push_back(source);
+  }
+
+  if (target.types_header)
+  {
+    const OutputFile types = { directory + "greg_types.h.in", types_path(target) };
+    files.push_back(types);
   }
 
-  for (const auto ref : spec.select_nodes("/registry/types/type[@requires]"))
+  return files;
+}
+
+// Returns the template of the version and extension headers of the
+// specified target
+//
+wire::string module_template_path(const Target& target)
+{
+  return directory_name(target.template_path) + "greg_module.h.in";
+}
+
+// Returns every template used by the specified target
+//
+std::vector<wire::string> template_paths(const Target& target)
+{
+  std::vector<wire::string> paths;
+
+  for (const OutputFile& file : output_files(target))
+    paths.push_back(file.template_path);
+
+  if (target.modular)
+    paths.push_back(module_template_path(target));
+
+  return paths;
+}
+
+// The version of the code generated from a manifest, which is part of every
+// fingerprint so that stamps written by older versions of greg don't match
+// Bump the version whenever the generated code changes for the same inputs
+//
+const uint32_t output_version = 8;
+
+// Returns the fingerprint of all inputs of the specified target
+// Any target field affecting the output must be included here
+//
+uint64_t target_fingerprint(const Target& target,
+                            uint64_t spec_hash,
+                            uint64_t template_hash)
+{
+  std::ostringstream description;
+  description << output_version << ' ' << cache_version << ' ' << spec_hash << ' ' << template_hash << ' '
+              << target.api << ' ' << target.profile << ' '
+              << target.version.major << '.' << target.version.minor << ' '
+              << target.direct_version.major << '.' << target.direct_version.minor << ' '
+              << target.split << target.types_header << target.modular
+              << target.profiling << target.tracing;
+
+  for (const wire::string& extension : target.extensions)
+    description << ' ' << extension;
+
+  if (!target.usage_path.empty())
   {
-    const pugi::xml_node tn = ref.node();
+    const wire::string usage = read_file(target.usage_path.c_str());
+    description << ' ' << hash_data(usage.data(), usage.size());
+  }
 
-    if (manifest.types.count(type_name(tn)) && api_name(tn) == target.api)
-      manifest.types.insert(tn.attribute("requires").value());
+  if (!target.scan_path.empty())
+  {
+    for (const std::string& name : scan_sources(target.scan_path))
+      description << ' ' << name;
   }
 
-  return manifest;
+  const std::string text = description.str();
+  return hash_data(text.data(), text.size());
 }
 
-// Generates output strings from the specified document according to the
-// specified manifest and target
+// Returns the path of the fingerprint stamp of the specified target
 //
-Output generate_output(const Manifest& manifest,
-                       const Target& target,
-                       const pugi::xml_document& spec)
+wire::string stamp_path(const Target& target)
 {
-  Output output;
+  return target.output_path + ".stamp";
+}
 
-  if (target.api == "gl")
-    output.api_name = "OpenGL";
-  else if (target.api == "gles1" || target.api == "gles2")
-    output.api_name = "OpenGL ES";
+// Checks whether the stamp of the specified target matches the specified
+// fingerprint and every file it lists still has the size and hash it was
+// written with
+//
+bool target_up_to_date(const Target& target, uint64_t fingerprint)
+{
+  std::ifstream stamp(stamp_path(target).c_str(), std::ios::in | std::ios::binary);
+
+  uint64_t stamped;
+  if (!(stamp >> stamped) || stamped != fingerprint)
+    return false;
+
+  size_t count = 0;
+  ContentHash expected;
+  std::string path;
+
+  while (stamp >> expected.size >> expected.hash && std::getline(stamp >> std::ws, path))
+  {
+    MappedFile existing;
+    if (!existing.open(path.c_str()) || existing.size != expected.size ||
+        hash_data(existing.data, existing.size) != expected.hash)
+    {
+      return false;
+    }
+
+    count++;
+  }
+
+  return count > 0;
+}
+
+// Records the specified fingerprint and the size and hash of every file
+// written for the specified target in its stamp
+//
+void write_stamp(const Target& target,
+                 uint64_t fingerprint,
+                 const std::vector<WrittenFile>& files)
+{
+  std::ofstream stamp(stamp_path(target).c_str(),
+                      std::ios::out | std::ios::trunc | std::ios::binary);
+  if (stamp.fail())
+    error("Failed to create file");
+
+  stamp << fingerprint << '\n';
+
+  for (const WrittenFile& file : files)
+    stamp << file.hash.size << ' ' << file.hash.hash << ' ' << file.path << '\n';
+}
+
+// Wall time, heap and counter statistics collected for --stats
+// Phases and counters with the same name are summed when repeated, e.g.
+// once per target in batch mode
+//
+class Stats
+{
+public:
+  Stats(): heap_max(0) { }
+  void add_phase(const char* name, double seconds, size_t base, size_t peak)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    heap_max = std::max(heap_max, peak);
+    peak = peak > base ? peak - base : 0;
+
+    for (PhaseStats& phase : phases)
+    {
+      if (phase.name == name)
+      {
+        phase.seconds += seconds;
+        phase.peak = std::max(phase.peak, peak);
+        return;
+      }
+    }
 
-  for (const wire::string& extension : manifest.extensions)
+    const PhaseStats phase = { name, seconds, peak };
+    phases.push_back(phase);
+  }
+  void count(const char* name, size_t value)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for (Counter& counter : counters)
+    {
+      if (counter.name == name)
+      {
+        counter.value += value;
+        return;
+      }
+    }
+
+    const Counter counter = { name, value };
+    counters.push_back(counter);
+  }
+  void print(std::FILE* file) const
   {
-    wire::string boolean_name = extension;
-    if (boolean_name.starts_with("GL_"))
-      boolean_name.replace(0, 3, "GREG_");
+    double total = 0.0;
+
+    std::fprintf(file, "%-12s %12s %14s\n", "phase", "time (ms)", "peak heap (KB)");
+    for (const PhaseStats& phase : phases)
+    {
+      std::fprintf(file, "%-12s %12.3f %14.1f\n",
+                   phase.name, phase.seconds * 1000.0, phase.peak / 1024.0);
+      total += phase.seconds;
+    }
 
-    output.ext_macros += wire::string("#define \1 1\n", extension);
-    output.ext_declarations += wire::string("extern int \1;\n", boolean_name);
-    output.ext_definitions += wire::string("GREGDEF int \1 = 0;\n", boolean_name);
-    output.ext_loaders += wire::string("    \1 = gregExtensionSupported(\"\2\");\n",
-                                       boolean_name,
-                                       extension);
+    std::fprintf(file, "%-12s %12.3f %14.1f\n",
+                 "total", total * 1000.0, heap_max / 1024.0);
+
+    for (const Counter& counter : counters)
+      std::fprintf(file, "%-16s %9lu\n", counter.name, (unsigned long) counter.value);
   }
+  void print_json(std::FILE* file) const
+  {
+    std::fprintf(file, "{\n  \"phases\": [\n");
+    for (size_t i = 0;  i < phases.size();  i++)
+    {
+      std::fprintf(file, "    { \"name\": \"%s\", \"seconds\": %.6f, \"peak_bytes\": %lu }%s\n",
+                   phases[i].name,
+                   phases[i].seconds,
+                   (unsigned long) phases[i].peak,
+                   i + 1 < phases.size() ? "," : "");
+    }
 
-  for (const Feature& feature : manifest.features)
+    std::fprintf(file, "  ],\n  \"peak_bytes\": %lu,\n  \"counts\": {\n",
+                 (unsigned long) heap_max);
+    for (size_t i = 0;  i < counters.size();  i++)
+    {
+      std::fprintf(file, "    \"%s\": %lu%s\n",
+                   counters[i].name,
+                   (unsigned long) counters[i].value,
+                   i + 1 < counters.size() ? "," : "");
+    }
+
+    std::fprintf(file, "  }\n}\n");
+  }
+private:
+  struct PhaseStats
   {
-    wire::string boolean_name = feature.name;
-    if (boolean_name.starts_with("GL_"))
-      boolean_name.replace(0, 3, "GREG_");
+    const char* name;
+    double seconds;
+    size_t peak;
+  };
+  struct Counter
+  {
+    const char* name;
+    size_t value;
+  };
+  std::mutex mutex;
+  size_t heap_max;
+  std::vector<PhaseStats> phases;
+  std::vector<Counter> counters;
+};
 
-    output.ver_macros += wire::string("#define \1 1\n", feature.name);
-    output.ver_declarations += wire::string("extern int \1;\n", boolean_name);
-    output.ver_definitions += wire::string("GREGDEF int \1 = 0;\n", boolean_name);
-    output.ver_loaders += wire::string("    \1 = gregVersionSupported(\2, \3);\n",
-                                       boolean_name,
-                                       feature.version.major,
-                                       feature.version.minor);
+// Measures a phase of a run and records it in the specified stats, if any
+// The peak is the highest heap usage during the phase above its start
+//
+class Phase
+{
+public:
+  Phase(Stats* stats, const char* name): stats(stats), name(NULL)
+  {
+    next(name);
   }
+  ~Phase() { end(); }
+  void next(const char* next_name)
+  {
+    end();
 
-  for (const auto ref : spec.select_nodes("/registry/types/type"))
+    if (stats)
+    {
+      name = next_name;
+      base = heap_size;
+      heap_peak = base;
+      start = std::chrono::steady_clock::now();
+    }
+  }
+  void end()
   {
-    const pugi::xml_node tn = ref.node();
+    if (!name)
+      return;
 
-    if (!manifest.types.count(type_name(tn)) || api_name(tn) != target.api)
-      continue;
+    const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
 
-    output.type_typedefs += wire::string("\1\n", scrape_type_text(tn));
+    stats->add_phase(name, elapsed.count(), base, heap_peak);
+    name = NULL;
   }
+private:
+  Stats* stats;
+  const char* name;
+  size_t base;
+  std::chrono::steady_clock::time_point start;
+};
 
-  for (const auto ref : spec.select_nodes("/registry/enums/enum"))
+// Applies a target option to the specified target
+// Returns false if the option does not describe a target
+//
+bool set_target_option(Target& target, int option, const char* value)
+{
+  switch (option)
   {
-    const pugi::xml_node en = ref.node();
+    case Option::API:
+      target.api = value;
 
-    if (!manifest.enums.count(en.attribute("name").value()))
-      continue;
+      // Window system loaders default to their own registry, template and
+      // output, so they can be generated next to an OpenGL loader
+      if (is_window_system_api(target.api))
+      {
+        if (target.spec_path == "spec/gl.xml")
+          target.spec_path = "spec/" + target.api + ".xml";
+        if (target.template_path == "templates/greg.h.in")
+          target.template_path = "templates/wsi.h.in";
+        if (target.output_path == "output/greg.h")
+          target.output_path = "output/greg_" + target.api + ".h";
+      }
+      return true;
+
+    case Option::CORE:
+      target.profile = "core";
+      return true;
+
+    case Option::VERSION:
+      target.version = Version(value);
+      return true;
+
+    case Option::EXTENSIONS:
+      for (auto e : wire::string(value).split(","))
+        target.extensions.insert(e);
+      return true;
+
+    case Option::TEMPLATE:
+      target.template_path = value;
+      return true;
+
+    case Option::OUTPUT:
+      target.output_path = value;
+      return true;
+
+    case Option::SPEC:
+      target.spec_path = value;
+      return true;
+
+    case Option::SPLIT:
+      target.split = true;
+      return true;
+
+    case Option::TYPES_HEADER:
+      target.types_header = true;
+      return true;
+
+    case Option::MODULAR:
+      target.modular = true;
+      target.types_header = true;
+      return true;
 
-    output.enum_definitions += wire::string("#define \1 \2\n",
-                                            en.attribute("name").value(),
-                                            en.attribute("value").value());
+    case Option::PROFILING:
+      target.profiling = true;
+      return true;
+
+    case Option::TRACING:
+      target.tracing = true;
+      return true;
+
+    case Option::USAGE:
+      target.usage_path = value;
+      return true;
+
+    case Option::DIRECT:
+      target.direct_version = Version(value);
+      return true;
+
+    case Option::SCAN:
+      target.scan_path = value;
+      return true;
   }
 
-  for (const auto ref : spec.select_nodes("/registry/commands/command"))
+  return false;
+}
+
+// Fails if the specified target asks for something its API does not support
+//
+void check_target(const Target& target)
+{
+  if (!is_window_system_api(target.api))
+    return;
+
+  if (target.split || target.types_header || target.modular)
+    error("Window system loaders cannot be split");
+  if (target.profiling || target.tracing)
+    error("Window system loaders cannot be instrumented");
+  if (target.direct_version.major)
+    error("Window system loaders cannot link functions directly");
+}
+
+// Returns the targets listed in the specified batch file
+// Each non-empty line not starting with # describes one target, using the
+// same target options as the command line, and starts out as a copy of
+// the specified defaults
+//
+std::vector<Target> read_batch(const char* path, const Target& defaults)
+{
+  std::vector<Target> targets;
+  std::istringstream lines(read_file(path));
+  std::string line;
+
+  while (std::getline(lines, line))
   {
-    const pugi::xml_node cn = ref.node();
+    std::istringstream words(line);
+    std::string word;
 
-    const wire::string function_name = cn.child("proto").child_value("name");
-    if (!manifest.commands.count(function_name))
+    if (!(words >> word) || word[0] == '#')
       continue;
 
-    const wire::string typedef_name("PFN\1PROC", function_name.uppercase());
-    const wire::string pointer_name("greg_\1", function_name);
-
-    output.cmd_typedefs += wire::string("typedef \1 (GLAPIENTRY *\2)(\3);\n",
-                                        scrape_proto_text(cn.child("proto")),
-                                        typedef_name,
-                                        command_params(cn));
-    output.cmd_declarations += wire::string("extern \1 \2;\n",
-                                            typedef_name,
-                                            pointer_name);
-    output.cmd_macros += wire::string("#define \1 \2\n",
-                                      function_name,
-                                      pointer_name);
-    output.cmd_definitions += wire::string("GREGDEF \1 \2 = NULL;\n",
-                                           typedef_name,
-                                           pointer_name);
-    output.cmd_loaders += wire::string("    \1 = (\2) gregGetProcAddress(\"\3\");\n",
-                                       pointer_name,
-                                       typedef_name,
-                                       function_name);
+    Target target = defaults;
+
+    do
+    {
+      if (word.compare(0, 2, "--") != 0)
+        error("Invalid option in batch file");
+
+      const size_t separator = word.find('=');
+      const std::string name = word.substr(2, separator - 2);
+      const char* value = separator == std::string::npos ? "" : word.c_str() + separator + 1;
+
+      const option* o = options;
+      while (o->name && name != o->name)
+        o++;
+
+      if (!o->name || !set_target_option(target, o->val, value))
+        error("Invalid option in batch file");
+    }
+    while (words >> word);
+
+    targets.push_back(target);
   }
 
-  return output;
+  return targets;
 }
 
-// Writes the specified text to the specified path
+// The parsed templates used by a set of targets, by path
+//
+typedef std::map<wire::string, Template> Templates;
+
+// Generates the loader for the specified target and writes it to its
+// output path, adding every file it generates to the specified list
 //
-void write_file(const char* path, const wire::string& content)
+void generate_target(const Target& target,
+                     const Registry& registry,
+                     const Templates& templates,
+                     std::vector<WrittenFile>& files,
+                     Stats* stats)
 {
-  std::ofstream stream(path, std::ios::out | std::ios::trunc | std::ios::binary);
-  if (stream.fail())
-    error("Failed to create file");
+  Phase phase(stats, "manifest");
+  const Manifest manifest = generate_manifest(target, registry);
+
+  phase.next("output");
+  const Output output = generate_output(manifest, target, registry);
+
+  const Tags tags = output_tags(output);
+  size_t output_bytes = 0, files_written = 0;
+
+  if (target.modular)
+    make_directory(module_directory(target));
+
+  for (const OutputFile& file : output_files(target))
+  {
+    phase.next("template");
+    const Template& content = templates.find(file.template_path)->second;
+    const ContentHash hash = hash_content(content, tags);
+    output_bytes += hash.size;
 
-  stream << content;
+    phase.next("write");
+    files_written += write_content(file.path.c_str(), content, tags, hash);
+
+    const WrittenFile written = { file.path, hash };
+    files.push_back(written);
+  }
+
+  if (target.modular)
+  {
+    const Template& content = templates.find(module_template_path(target))->second;
+    const wire::string directory = module_directory(target);
+
+    for (const ModuleOutput& module : output.module_outputs)
+    {
+      phase.next("template");
+      const Tags file_tags = module_tags(tags, output, module);
+      const ContentHash hash = hash_content(content, file_tags);
+      output_bytes += hash.size;
+
+      phase.next("write");
+      const wire::string path = directory + module.name.str() + ".h";
+      files_written += write_content(path.c_str(), content, file_tags, hash);
+
+      const WrittenFile written = { path, hash };
+      files.push_back(written);
+    }
+  }
+
+  phase.end();
+
+  if (stats)
+  {
+    stats->count("targets", 1);
+    stats->count("files_written", files_written);
+    stats->count("features", manifest.features.size());
+    stats->count("extensions", manifest.extensions.size());
+    stats->count("types", output.type_count);
+    stats->count("enums", output.enum_count);
+    stats->count("commands", output.command_count);
+    stats->count("output_bytes", output_bytes);
+  }
 }
 
-// Returns the text of the specified file
+// Generates the specified targets on up to the specified number of threads
+// and returns the files generated for each of them
+// The registry and templates are only ever read, so they are shared by all
+// threads
 //
-wire::string read_file(const char* path)
+std::vector<std::vector<WrittenFile>> generate_targets(const std::vector<Target>& targets,
+                                                       const Registry& registry,
+                                                       const Templates& templates,
+                                                       unsigned int jobs,
+                                                       Stats* stats)
 {
-  std::ifstream stream(path, std::ios::in | std::ios::binary);
-  if (stream.fail())
-    error("File not found");
+  std::vector<std::vector<WrittenFile>> files(targets.size());
+  std::atomic<size_t> next(0);
 
-  std::ostringstream contents;
-  contents << stream.rdbuf();
-  return contents.str();
+  auto worker = [&]()
+  {
+    size_t index;
+    while ((index = next++) < targets.size())
+      generate_target(targets[index], registry, templates, files[index], stats);
+  };
+
+  jobs = std::min<size_t>(std::max(jobs, 1u), targets.size());
+  if (jobs <= 1)
+  {
+    worker();
+    return files;
+  }
+
+  std::vector<std::thread> threads;
+  for (unsigned int i = 0;  i < jobs;  i++)
+    threads.push_back(std::thread(worker));
+
+  for (std::thread& thread : threads)
+    thread.join();
+
+  return files;
 }
 
-// Returns the text of the specified file, with any tags replaced by the
-// specified output strings
+// Generates the specified targets from the registry at the specified spec
+// path, using the registry cache at the specified path if it was built from
+// that spec, or only builds that cache if asked to
 //
-wire::string generate_content(const Output& output, const char* path)
+void generate_from_spec(const wire::string& spec_path,
+                        const wire::string& cache_path,
+                        std::vector<Target> targets,
+                        const Templates& templates,
+                        bool build_cache,
+                        bool fingerprint,
+                        unsigned int jobs,
+                        Stats& stats,
+                        Stats* run_stats)
 {
-  wire::string text = read_file(path);
+  // The spec is mapped copy-on-write and parsed in place, so the document
+  // points into the mapped pages instead of into copies of them
+  Phase phase(run_stats, "spec");
+  MappedFile spec_file;
+  if (!spec_file.open(spec_path.c_str(), true))
+    error("File not found");
+
+  const uint64_t spec_hash = hash_data(spec_file.data, spec_file.size);
 
-  text = text.replace("@API_NAME@", output.api_name);
-  text = text.replace("@TYPE_TYPEDEFS@", output.type_typedefs);
-  text = text.replace("@ENUM_DEFINITIONS@", output.enum_definitions);
-  text = text.replace("@EXT_MACROS@", output.ext_macros);
-  text = text.replace("@VER_MACROS@", output.ver_macros);
-  text = text.replace("@EXT_DECLARATIONS@", output.ext_declarations);
-  text = text.replace("@VER_DECLARATIONS@", output.ver_declarations);
-  text = text.replace("@EXT_DEFINITIONS@", output.ext_definitions);
-  text = text.replace("@VER_DEFINITIONS@", output.ver_definitions);
-  text = text.replace("@VER_LOADERS@", output.ver_loaders);
-  text = text.replace("@EXT_LOADERS@", output.ext_loaders);
-  text = text.replace("@CMD_TYPEDEFS@", output.cmd_typedefs);
-  text = text.replace("@CMD_DECLARATIONS@", output.cmd_declarations);
-  text = text.replace("@CMD_MACROS@", output.cmd_macros);
-  text = text.replace("@CMD_DEFINITIONS@", output.cmd_definitions);
-  text = text.replace("@CMD_LOADERS@", output.cmd_loaders);
+  // Skip every target whose inputs match its stamp, and the registry along
+  // with them if nothing is left to generate
+  std::vector<uint64_t> fingerprints;
+  if (fingerprint && !build_cache)
+  {
+    std::vector<Target> stale;
+
+    for (const Target& t : targets)
+    {
+      uint64_t hash = hash_basis;
+      for (const wire::string& path : template_paths(t))
+      {
+        const uint64_t file_hash = templates.find(path)->second.hash;
+        hash = hash_data((const char*) &file_hash, sizeof(file_hash), hash);
+      }
+
+      const uint64_t value = target_fingerprint(t, spec_hash, hash);
+
+      if (!target_up_to_date(t, value))
+      {
+        stale.push_back(t);
+        fingerprints.push_back(value);
+      }
+    }
+
+    targets.swap(stale);
+    if (targets.empty())
+      return;
+  }
+
+  // Use the registry cache if it was built from this spec, as mapping it is
+  // much faster than parsing the XML
+  phase.next("registry");
+  MappedFile cache;
+  Registry registry;
+  pugi::xml_document spec;
+
+  if (build_cache || !cache.open(cache_path.c_str()) ||
+      !CacheReader(cache.data, cache.size).read_registry(registry, spec_hash))
+  {
+    cache.close();
+    registry = Registry();
 
-  return text;
+    // Only the parts of the spec the targets may use are parsed, unless
+    // the whole registry is going into the cache
+    size_t spec_size = spec_file.size;
+    if (!build_cache)
+    {
+      spec_size = filter_spec(spec_file.data, spec_file.size, targets);
+      stats.count("spec_kept_bytes", spec_size);
+    }
+
+    const pugi::xml_parse_result result =
+      spec.load_buffer_inplace(spec_file.data, spec_size);
+    if (!result)
+      error("Failed to parse file");
+
+    registry = load_registry(spec);
+  }
+  else
+    stats.count("registry_cached", 1);
+
+  phase.end();
+
+  if (build_cache)
+  {
+    CacheWriter writer;
+    writer.add_registry(registry);
+    if (!writer.write(cache_path.c_str(), spec_hash))
+      error("Failed to create file");
+
+    return;
+  }
+
+  const std::vector<std::vector<WrittenFile>> files =
+    generate_targets(targets, registry, templates, jobs, run_stats);
+
+  for (size_t i = 0;  i < fingerprints.size();  i++)
+    write_stamp(targets[i], fingerprints[i], files[i]);
 }
 
 } /* namespace */
 
 int main(int argc, char** argv)
 {
-  enum Option { API, CORE, VERSION, EXTENSIONS, HELP };
-
   int ch;
-  Target target = { "gl", "", { 4, 5 } };
-  const option options[] =
-  {
-    { "api", 1, NULL, Option::API },
-    { "core", 0, NULL, Option::CORE },
-    { "version", 1, NULL, Option::VERSION },
-    { "extensions", 1, NULL, Option::EXTENSIONS },
-    { "help", 0, NULL, Option::HELP },
-    { NULL, 0, NULL, 0 }
-  };
+  Target target = { "gl", "", { 4, 5 }, { 0, 0 }, { }, "templates/greg.h.in", "output/greg.h", "spec/gl.xml", "", "", false, false, false, false, false };
+  wire::string cache_path;
+  const char* batch_path = NULL;
+  unsigned int jobs = std::thread::hardware_concurrency();
+  bool build_cache = false;
+  bool fingerprint = false;
+  bool print_stats = false;
+  const char* stats_path = NULL;
 
   while ((ch = getopt_long(argc, argv, "h", options, NULL)) != -1)
   {
+    if (set_target_option(target, ch, optarg))
+      continue;
+
     switch (ch)
     {
-      case Option::API:
-        target.api = optarg;
+      case Option::CACHE:
+        cache_path = optarg;
+        break;
+
+      case Option::BUILD_CACHE:
+        build_cache = true;
+        break;
+
+      case Option::BATCH:
+        batch_path = optarg;
+        break;
+
+      case Option::JOBS:
+        jobs = std::atoi(optarg);
         break;
 
-      case Option::CORE:
-        target.profile = "core";
+      case Option::FINGERPRINT:
+        fingerprint = true;
         break;
 
-      case Option::VERSION:
-        target.version = Version(optarg);
+      case Option::STATS:
+        print_stats = true;
         break;
 
-      case Option::EXTENSIONS:
-        for (auto e : wire::string(optarg).split(","))
-          target.extensions.insert(e);
+      case Option::STATS_JSON:
+        stats_path = optarg;
         break;
 
       case 'h':
@@ -507,21 +4120,75 @@ int main(int argc, char** argv)
     }
   }
 
-  std::ifstream stream("spec/gl.xml");
-  if (stream.fail())
-    error("File not found");
+  std::vector<Target> targets;
+  if (batch_path)
+    targets = read_batch(batch_path, target);
+  else
+    targets.push_back(target);
 
-  pugi::xml_document spec;
+  for (const Target& t : targets)
+    check_target(t);
+
+  // Heap statistics are only meaningful for one phase at a time
+  Stats stats;
+  Stats* run_stats = NULL;
+  if (print_stats || stats_path)
+  {
+    run_stats = &stats;
+    jobs = 1;
+    heap_tracking = true;
+  }
+
+  pugi::set_memory_management_functions(tracked_allocate, tracked_deallocate);
+
+  // Targets are grouped by the registry they are generated from, so each
+  // registry is loaded once however many targets use it
+  std::map<wire::string, std::vector<Target>> groups;
+  if (build_cache)
+    groups[target.spec_path];
+  else
+  {
+    for (const Target& t : targets)
+      groups[t.spec_path].push_back(t);
+  }
+
+  Phase phase(run_stats, "templates");
+  Templates templates;
+  for (const Target& t : targets)
+  {
+    for (const wire::string& path : template_paths(t))
+    {
+      if (!templates.count(path))
+        templates.insert(std::make_pair(path, Template(path)));
+    }
+  }
 
-  const pugi::xml_parse_result result = spec.load(stream);
-  if (!result)
-    error("Failed to parse file");
+  phase.end();
 
-  const Manifest manifest = generate_manifest(target, spec);
-  const Output output = generate_output(manifest, target, spec);
+  // The cache defaults to the spec path with .cache instead of .xml, and
+  // one given on the command line belongs to the spec given there
+  for (const auto& group : groups)
+  {
+    wire::string group_cache_path = replace_suffix(group.first, ".xml", ".cache");
+    if (!cache_path.empty() && group.first == target.spec_path)
+      group_cache_path = cache_path;
+
+    generate_from_spec(group.first, group_cache_path, group.second, templates,
+                       build_cache, fingerprint, jobs, stats, run_stats);
+  }
+
+  if (print_stats)
+    stats.print(stdout);
 
-  write_file("output/greg.h", generate_content(output, "templates/greg.h.in"));
+  if (stats_path)
+  {
+    std::FILE* file = std::fopen(stats_path, "w");
+    if (!file)
+      error("Failed to create file");
+
+    stats.print_json(file);
+    std::fclose(file);
+  }
 
   std::exit(EXIT_SUCCESS);
 }
-
@@ -0,0 +1,18 @@
+/* A source using a debug callback only through its typedef
+ *
+ * The scan test generates a loader with --scan on this directory and
+ * compiles this file against it, including the implementation, to check
+ * that pruning keeps every type the remaining declarations use
+ */
+
+#define GREG_IMPLEMENTATION
+#include "greg.h"
+
+int setDebugCallback(PFNGLDEBUGMESSAGECALLBACKPROC callback, GLDEBUGPROC function)
+{
+    if (!callback)
+        return 0;
+
+    callback(function, NULL);
+    return 1;
+}